@@ -0,0 +1,593 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//           Seats analyzer library benchmark            //
+///////////////////////////////////////////////////////////
+
+// Usage: benchmark [options]
+//   --images DIR           benchmark all .jpg/.jpeg/.png images from DIR (default ../../data/images/)
+//   --synthetic WxH        benchmark generated images of the given size instead of files
+//   --num-synthetic N      number of generated images (default 8)
+//   --warmup N             passes over the image list excluded from measurement (default 2)
+//   --iterations N         measured passes over the image list by each thread (default 10)
+//   --threads N            number of worker threads, each with its own SAState (default 1)
+//   --sdk-threads N        SaConfig::num_threads of every state (default 1)
+//   --cpu-dispatch NAME    image kernels auto|scalar|sse4|avx2 (default auto)
+//   --precision fp32|int8  inference precision (default fp32)
+//   --no-scl               measure saRunDet only
+//   --config FILE          SDK config file (default ../../sdk/config.ini)
+//   --output FILE          write the JSON report to FILE instead of stdout
+//
+// The report contains the throughput and p50/p95/p99/max latency of saRunDet and saRunScl
+// and the peak resident set size of the process.
+
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#ifdef _WIN32
+#   include <windows.h>
+#   include <psapi.h>
+#else
+#   include <dirent.h>
+#   include <sys/resource.h>
+#endif
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+struct BenchmarkOptions
+{
+    std::string images_dir = IMAGES_DIR;
+    std::string config_filename = CONFIG_FILENAME;
+    std::string output_filename;
+    unsigned int synthetic_width = 0;       // zero for images from images_dir
+    unsigned int synthetic_height = 0;
+    int num_synthetic = 8;
+    int warmup = 2;
+    int iterations = 10;
+    int threads = 1;
+    int sdk_threads = 1;
+    SaCpuDispatch cpu_dispatch = SA_CPU_DISPATCH_AUTO;
+    SaPrecision precision = SA_PRECISION_FP32;
+    bool run_scl = true;
+};
+
+static const char *CPU_DISPATCH_NAMES[] = {"auto", "scalar", "sse4", "avx2"};
+
+// Latencies and counters measured by one worker thread
+struct ThreadMeasurement
+{
+    std::vector<double> det_latencies_ms;
+    std::vector<double> scl_latencies_ms;
+    unsigned int num_det_errors = 0;
+    unsigned int num_scl_errors = 0;
+};
+
+static bool parseOptions(int argc, char *argv[], BenchmarkOptions *options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--no-scl")
+        {
+            options->run_scl = false;
+        }
+        else if (arg == "--images" && has_value)
+        {
+            options->images_dir = argv[++i];
+        }
+        else if (arg == "--synthetic" && has_value)
+        {
+            if (std::sscanf(argv[++i], "%ux%u", &options->synthetic_width, &options->synthetic_height) != 2 ||
+                options->synthetic_width == 0 || options->synthetic_height == 0)
+            {
+                std::cerr << "Invalid synthetic image size: " << argv[i] << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--num-synthetic" && has_value)
+        {
+            options->num_synthetic = std::atoi(argv[++i]);
+        }
+        else if (arg == "--warmup" && has_value)
+        {
+            options->warmup = std::atoi(argv[++i]);
+        }
+        else if (arg == "--iterations" && has_value)
+        {
+            options->iterations = std::atoi(argv[++i]);
+        }
+        else if (arg == "--threads" && has_value)
+        {
+            options->threads = std::atoi(argv[++i]);
+        }
+        else if (arg == "--sdk-threads" && has_value)
+        {
+            options->sdk_threads = std::atoi(argv[++i]);
+        }
+        else if (arg == "--cpu-dispatch" && has_value)
+        {
+            std::string name = argv[++i];
+            int d = 0;
+            while (d < 4 && name != CPU_DISPATCH_NAMES[d])
+            {
+                d++;
+            }
+            if (d == 4)
+            {
+                std::cerr << "Unknown CPU dispatch: " << name << std::endl;
+                return false;
+            }
+            options->cpu_dispatch = (SaCpuDispatch)d;
+        }
+        else if (arg == "--precision" && has_value)
+        {
+            std::string name = argv[++i];
+            if (name != "fp32" && name != "int8")
+            {
+                std::cerr << "Unknown precision: " << name << std::endl;
+                return false;
+            }
+            options->precision = name == "int8" ? SA_PRECISION_INT8 : SA_PRECISION_FP32;
+        }
+        else if (arg == "--config" && has_value)
+        {
+            options->config_filename = argv[++i];
+        }
+        else if (arg == "--output" && has_value)
+        {
+            options->output_filename = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            return false;
+        }
+    }
+    if (options->num_synthetic < 1 || options->warmup < 0 || options->iterations < 1 ||
+        options->threads < 1 || options->sdk_threads < 1)
+    {
+        std::cerr << "Invalid option value" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool hasImageExtension(const std::string& filename)
+{
+    size_t dot = filename.find_last_of('.');
+    if (dot == std::string::npos)
+    {
+        return false;
+    }
+    std::string ext = filename.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == "jpg" || ext == "jpeg" || ext == "png";
+}
+
+// Lists image files of a directory in alphabetical order
+static std::vector<std::string> listImages(const std::string& dir)
+{
+    std::vector<std::string> filenames;
+    std::string prefix = dir;
+    if (!prefix.empty() && prefix.back() != '/' && prefix.back() != '\\')
+    {
+        prefix += "/";
+    }
+#ifdef _WIN32
+    WIN32_FIND_DATAA find_data;
+    HANDLE hfind = FindFirstFileA((prefix + "*").c_str(), &find_data);
+    if (hfind != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if (hasImageExtension(find_data.cFileName))
+            {
+                filenames.push_back(prefix + find_data.cFileName);
+            }
+        } while (FindNextFileA(hfind, &find_data));
+        FindClose(hfind);
+    }
+#else
+    DIR *dirp = opendir(dir.c_str());
+    if (dirp != nullptr)
+    {
+        for (struct dirent *entry = readdir(dirp); entry != nullptr; entry = readdir(dirp))
+        {
+            if (hasImageExtension(entry->d_name))
+            {
+                filenames.push_back(prefix + entry->d_name);
+            }
+        }
+        closedir(dirp);
+    }
+#endif
+    std::sort(filenames.begin(), filenames.end());
+    return filenames;
+}
+
+// Fills a BGR image with a deterministic gradient and noise pattern
+static void fillSynthetic(ERImage *image, unsigned int seed)
+{
+    unsigned int state = seed * 2654435761u + 1u;
+    for (unsigned int y = 0; y < image->height; y++)
+    {
+        unsigned char *row = image->row_data[y];
+        for (unsigned int x = 0; x < image->width; x++)
+        {
+            state = state * 1664525u + 1013904223u;
+            unsigned int noise = (state >> 24) & 0x3F;
+            row[3 * x + 0] = (unsigned char)((x * 255 / image->width + noise) & 0xFF);
+            row[3 * x + 1] = (unsigned char)((y * 255 / image->height + noise) & 0xFF);
+            row[3 * x + 2] = (unsigned char)(((x + y) * 127 / (image->width + image->height) + noise) & 0xFF);
+        }
+    }
+}
+
+// Processes the whole image list, saRunDet on each image and saRunScl on each window detection.
+// A synthetic image rarely contains a windshield, its centre is classified instead so that saRunScl is measured too.
+static void processImages(const SaAPI *api, SAState sa_state, const std::vector<ERImage> *images,
+                          int num_passes, bool run_scl, bool synthetic, ThreadMeasurement *measurement)
+{
+    for (int r = 0; r < num_passes; r++)
+    {
+        for (size_t i = 0; i < images->size(); i++)
+        {
+            const ERImage& image = (*images)[i];
+            SaDetResult det_result;
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            if (api->saRunDet(sa_state, image, nullptr, &det_result) != 0)
+            {
+                measurement->num_det_errors += 1;
+                continue;
+            }
+            measurement->det_latencies_ms.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now() - t1).count() / 1e6);
+
+            std::vector<ERRotatedRect> positions;
+            std::vector<const char *> labels;
+            for (int j = 0; j < det_result.num_detections && run_scl; j++)
+            {
+                SaDetection& det = det_result.detections[j];
+                // Classify only a windshield detections
+                if (std::strncmp((char *)det.label, "window", sizeof("window") - 1) != 0)
+                {
+                    continue;
+                }
+                positions.push_back(det.position);
+                labels.push_back(det.label);
+            }
+            if (synthetic && run_scl && positions.empty())
+            {
+                ERRotatedRect centre;
+                centre.x = image.width / 2.f;
+                centre.y = image.height / 2.f;
+                centre.width = image.width / 2.f;
+                centre.height = image.height / 4.f;
+                centre.angle = 0.f;
+                positions.push_back(centre);
+                labels.push_back("window");
+            }
+
+            for (size_t k = 0; k < positions.size(); k++)
+            {
+                SaDetectionLabel label;
+                std::strncpy(label, labels[k], SA_LABEL_STRING_LENGTH - 1);
+                label[SA_LABEL_STRING_LENGTH - 1] = '\0';
+                SaSclResult scl_result;
+                t1 = std::chrono::high_resolution_clock::now();
+                if (api->saRunScl(sa_state, image, &positions[k], label, &scl_result) != 0)
+                {
+                    measurement->num_scl_errors += 1;
+                    continue;
+                }
+                measurement->scl_latencies_ms.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::high_resolution_clock::now() - t1).count() / 1e6);
+            }
+            api->saFreeDetResult(sa_state, &det_result);
+        }
+    }
+}
+
+// Returns the nearest-rank percentile of sorted values
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0.;
+    }
+    size_t rank = (size_t)(p / 100. * sorted.size() + 0.999999);
+    rank = std::min(std::max(rank, (size_t)1), sorted.size());
+    return sorted[rank - 1];
+}
+
+// Escapes the string for a JSON string literal
+static std::string jsonEscape(const char *value)
+{
+    std::string escaped;
+    for (const char *c = value != nullptr ? value : ""; *c != '\0'; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            escaped += '\\';
+            escaped += *c;
+        }
+        else if ((unsigned char)*c < 0x20)
+        {
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", (unsigned int)(unsigned char)*c);
+            escaped += code;
+        }
+        else
+        {
+            escaped += *c;
+        }
+    }
+    return escaped;
+}
+
+static void printApiJson(FILE *out, const char *name, std::vector<double> latencies_ms, unsigned int num_errors,
+                         double wall_s, bool last)
+{
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    double sum_ms = 0.;
+    for (size_t i = 0; i < latencies_ms.size(); i++)
+    {
+        sum_ms += latencies_ms[i];
+    }
+    fprintf(out, "    \"%s\": {\n", name);
+    fprintf(out, "      \"count\": %zu,\n", latencies_ms.size());
+    fprintf(out, "      \"errors\": %u,\n", num_errors);
+    fprintf(out, "      \"throughput_hz\": %.3f,\n", wall_s > 0. ? latencies_ms.size() / wall_s : 0.);
+    fprintf(out, "      \"mean_ms\": %.4f,\n", latencies_ms.empty() ? 0. : sum_ms / latencies_ms.size());
+    fprintf(out, "      \"p50_ms\": %.4f,\n", percentile(latencies_ms, 50.));
+    fprintf(out, "      \"p95_ms\": %.4f,\n", percentile(latencies_ms, 95.));
+    fprintf(out, "      \"p99_ms\": %.4f,\n", percentile(latencies_ms, 99.));
+    fprintf(out, "      \"max_ms\": %.4f\n", latencies_ms.empty() ? 0. : latencies_ms.back());
+    fprintf(out, "    }%s\n", last ? "" : ",");
+}
+
+// Returns the peak resident set size of the process in kilobytes
+static unsigned long long peakRssKb()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return (unsigned long long)counters.PeakWorkingSetSize / 1024;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        return (unsigned long long)usage.ru_maxrss;
+    }
+    return 0;
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, &options))
+    {
+        return 1;
+    }
+
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cerr << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cerr << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cerr << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = options.sdk_threads;
+    config.cpu_dispatch = options.cpu_dispatch;
+    config.precision = options.precision;
+
+    SAState sa_state;
+    if (api.saInit(options.config_filename.c_str(), &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    // Read or generate the input images, the images are shared read-only by all threads
+    bool synthetic = options.synthetic_width > 0;
+    std::vector<ERImage> images;
+    if (synthetic)
+    {
+        for (int i = 0; i < options.num_synthetic; i++)
+        {
+            ERImage image;
+            if (api.erImageAllocate(&image, options.synthetic_width, options.synthetic_height,
+                                    ER_IMAGE_COLORMODEL_BGR, ER_IMAGE_DATATYPE_UCHAR) != 0)
+            {
+                break;
+            }
+            fillSynthetic(&image, (unsigned int)i);
+            images.push_back(image);
+        }
+    }
+    else
+    {
+        std::vector<std::string> filenames = listImages(options.images_dir);
+        for (size_t i = 0; i < filenames.size(); i++)
+        {
+            ERImage image;
+            if (api.erImageRead(&image, filenames[i].c_str()) != 0)
+            {
+                std::cerr << "Can't load the file: " << filenames[i] << std::endl;
+                continue;
+            }
+            images.push_back(image);
+        }
+    }
+    if (images.empty())
+    {
+        std::cerr << "No input images" << std::endl;
+        api.saFree(sa_state);
+        return 1;
+    }
+
+    // Every worker thread gets its own state sharing the models of the initialized one
+    std::vector<SAState> states(1, sa_state);
+    for (int t = 1; t < options.threads; t++)
+    {
+        SAState sa_state_clone;
+        if (api.saCloneState(sa_state, &sa_state_clone) != 0)
+        {
+            break;
+        }
+        states.push_back(sa_state_clone);
+    }
+    int num_threads = (int)states.size();
+
+    // Warm-up passes are not measured
+    std::vector<ThreadMeasurement> warmup(num_threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; t++)
+    {
+        workers.push_back(std::thread(processImages, &api, states[t], &images, options.warmup,
+                                      options.run_scl, synthetic, &warmup[t]));
+    }
+    for (size_t t = 0; t < workers.size(); t++)
+    {
+        workers[t].join();
+    }
+    workers.clear();
+
+    std::vector<ThreadMeasurement> measurements(num_threads);
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+    for (int t = 0; t < num_threads; t++)
+    {
+        workers.push_back(std::thread(processImages, &api, states[t], &images, options.iterations,
+                                      options.run_scl, synthetic, &measurements[t]));
+    }
+    for (size_t t = 0; t < workers.size(); t++)
+    {
+        workers[t].join();
+    }
+    double wall_s = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - t1).count() / 1e6;
+
+    // Merge the measurements of all threads
+    ThreadMeasurement total;
+    for (int t = 0; t < num_threads; t++)
+    {
+        total.det_latencies_ms.insert(total.det_latencies_ms.end(),
+            measurements[t].det_latencies_ms.begin(), measurements[t].det_latencies_ms.end());
+        total.scl_latencies_ms.insert(total.scl_latencies_ms.end(),
+            measurements[t].scl_latencies_ms.begin(), measurements[t].scl_latencies_ms.end());
+        total.num_det_errors += measurements[t].num_det_errors;
+        total.num_scl_errors += measurements[t].num_scl_errors;
+    }
+
+    FILE *out = stdout;
+    if (!options.output_filename.empty())
+    {
+        out = fopen(options.output_filename.c_str(), "w");
+        if (out == nullptr)
+        {
+            std::cerr << "Can't open the output file: " << options.output_filename << std::endl;
+            out = stdout;
+        }
+    }
+    fprintf(out, "{\n");
+    fprintf(out, "  \"sdk_version\": \"%s\",\n", jsonEscape(api.saVersion()).c_str());
+    fprintf(out, "  \"input\": \"%s\",\n", synthetic ? "synthetic" : "directory");
+    fprintf(out, "  \"num_images\": %zu,\n", images.size());
+    fprintf(out, "  \"image_width\": %u,\n", images[0].width);
+    fprintf(out, "  \"image_height\": %u,\n", images[0].height);
+    fprintf(out, "  \"warmup\": %d,\n", options.warmup);
+    fprintf(out, "  \"iterations\": %d,\n", options.iterations);
+    fprintf(out, "  \"threads\": %d,\n", num_threads);
+    fprintf(out, "  \"sdk_threads\": %d,\n", options.sdk_threads);
+    fprintf(out, "  \"cpu_dispatch\": \"%s\",\n", CPU_DISPATCH_NAMES[options.cpu_dispatch]);
+    fprintf(out, "  \"precision\": \"%s\",\n", options.precision == SA_PRECISION_INT8 ? "int8" : "fp32");
+    fprintf(out, "  \"wall_time_s\": %.4f,\n", wall_s);
+    fprintf(out, "  \"frames_per_second\": %.3f,\n", wall_s > 0. ? total.det_latencies_ms.size() / wall_s : 0.);
+    fprintf(out, "  \"peak_rss_kb\": %llu,\n", peakRssKb());
+    fprintf(out, "  \"apis\": {\n");
+    printApiJson(out, "saRunDet", total.det_latencies_ms, total.num_det_errors, wall_s, !options.run_scl);
+    if (options.run_scl)
+    {
+        printApiJson(out, "saRunScl", total.scl_latencies_ms, total.num_scl_errors, wall_s, true);
+    }
+    fprintf(out, "  }\n");
+    fprintf(out, "}\n");
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        api.erImageFree(&images[i]);
+    }
+
+    // Free the clones and the SDK state
+    for (int t = 1; t < num_threads; t++)
+    {
+        api.saFree(states[t]);
+    }
+    api.saFree(sa_state);
+    return 0;
+}
@@ -21,7 +21,6 @@
 
 #include <cstring>
 #include <iostream>
-#include <chrono>
 
 #include <SeatsAnalyzer.h>
 #include <er_explink.h>
@@ -84,6 +83,7 @@ int main(int argc, char *argv[])
     // Initialize the library
     SaConfig config={};
     std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
     /* optional values (NULL default) */
     /* detection related paths */
     // config.det_sdk_directory = "../../sdk/";
@@ -95,6 +95,9 @@ int main(int argc, char *argv[])
     // config.scl_model_filename = "CNN_TF2LITE_SCL_2022Q1.dat";
     // config.scl_model_p_table_filename = "CNN_TF2LITE_SCL_DATA_2022Q1.dat";
 
+    /* tracing, Chrome trace JSON written by saFree */
+    // config.trace_filename = "seatsanalyzer-trace.json";
+
     /* mandatory values if config is used */
 #ifdef SA_USE_GPU
     /**< Computation mode of the project, 0 - CPU computation, 1 - GPU */
@@ -114,13 +117,7 @@ int main(int argc, char *argv[])
     }
     /** [Init] */
 
-    // Process images
-    // Structures for measuring time
-    long long duration_det = 0;
-    unsigned int num_detector_runs = 0;
-    long long duration_scl = 0;
-    unsigned int num_scl_runs = 0;
-    // A variable holding the bounding box of an area of detector's interest
+    // Process images, see examples/benchmark for throughput and latency measurement
 
     for (int i = 0; i < NUM_IMG; i++)
     {
@@ -142,8 +139,6 @@ int main(int argc, char *argv[])
         /** [Det] */
         // Run detection
         SaDetResult det_result;
-        std::chrono::high_resolution_clock::time_point t1;
-        t1 = std::chrono::high_resolution_clock::now();
         if ((api.saRunDet(sa_state, er_image, roi, &det_result)) != 0)
         {
             // Wait for ENTER
@@ -153,9 +148,6 @@ int main(int argc, char *argv[])
         }
         /** [Det] */
 
-        duration_det += std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - t1).count();
-        num_detector_runs += 1;
-
         // Run SCL on each LP detection
         printf(" - found %d detections\n", det_result.num_detections);
         for (int j = 0; j < det_result.num_detections; j++)
@@ -174,8 +166,6 @@ int main(int argc, char *argv[])
                 continue;
             }
 
-            t1 = std::chrono::high_resolution_clock::now();
-
             /** [Scl] */
             // Run Seat Classification
             SaSclResult scl_result;
@@ -185,9 +175,6 @@ int main(int argc, char *argv[])
             }
             /** [Scl] */
 
-            duration_scl += std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - t1).count();
-            num_scl_runs += 1;
-
             // Print the classification results
             printf("  - left:   %s (%.2f) quality %.2f driver %s (%.2f) belt %s (%.2f) phone %s (%.2f)\n",
                 scl_result.left.occupied.result, scl_result.left.occupied.confidence,
@@ -220,19 +207,23 @@ int main(int argc, char *argv[])
     }
 
 
-    if (num_detector_runs > 0) {
-        printf("Detector speed:\n");
-        printf("%d evals, %lld ms\n", num_detector_runs, duration_det);
-        printf("Speed: %f ms/eval\n", duration_det / (double)num_detector_runs);
-        printf("Speed: %f Hz\n", (double)num_detector_runs / duration_det * 1000.);
-    }
-
-    if (num_scl_runs > 0) {
-        printf("Classifier speed:\n");
-        printf("%d evals, %lld ms\n", num_scl_runs, duration_scl);
-        printf("Speed: %f ms/eval\n", duration_scl / (double)num_scl_runs);
-        printf("Speed: %f Hz\n", (double)num_scl_runs / duration_scl * 1000.);
+    /** [Stats] */
+    // Print per-stage statistics collected by the SDK
+    SaStats stats;
+    if (api.saGetStats(sa_state, &stats) == 0) {
+        const char *stage_names[SA_NUM_STAGES] = {
+            "det preprocess", "det inference", "det postprocess",
+            "scl crop", "scl inference", "scl p-table"
+        };
+        printf("Stage statistics:\n");
+        for (int s = 0; s < SA_NUM_STAGES; s++) {
+            const SaStageStats& stage = stats.stages[s];
+            printf(" %-16s %6llu runs, p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+                stage_names[s], stage.count, stage.p50_ms, stage.p95_ms, stage.p99_ms, stage.max_ms);
+        }
+        printf(" %llu allocations, %llu bytes\n", stats.num_allocations, stats.bytes_allocated);
     }
+    /** [Stats] */
 
 
     /** [Free] */
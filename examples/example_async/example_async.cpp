@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//          Seats analyzer library async example         //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <atomic>
+#include <thread>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+// Data shared with the completion callback
+struct CallbackContext
+{
+    const SaAPI *api;
+    SAState sa_state;
+    std::atomic<int> num_finished;
+    std::atomic<int> num_detections;
+};
+
+/** [Callback] */
+// Completion callback, called from a worker thread of the SDK
+static void onDetFinished(const SaTaskResult *result, void *user_data)
+{
+    CallbackContext *context = (CallbackContext *)user_data;
+    if (result->status == 0)
+    {
+        context->num_detections += result->det_result.num_detections;
+        // The callback owns the detection result
+        SaDetResult det_result = result->det_result;
+        context->api->saFreeDetResult(context->sa_state, &det_result);
+    }
+    context->num_finished += 1;
+}
+/** [Callback] */
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 2;  /**< Number of threads to use, also the number of asynchronous workers */
+
+    SAState sa_state;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    // Images are decoded by this thread while the previous image is being processed by the SDK
+    std::vector<ERImage> images(NUM_IMG);
+    std::vector<SaTicket> tickets(NUM_IMG);
+    std::vector<bool> submitted(NUM_IMG, false);
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i <= NUM_IMG; i++)
+    {
+        if (i < NUM_IMG)
+        {
+            if (api.erImageRead(&images[i], TestImageList[i]) != 0)
+            {
+                std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+                images[i].data = nullptr;
+            }
+            else
+            {
+                /** [SubmitDet] */
+                // Submit detection, the image must stay valid until the task is finished
+                if (api.saSubmitDet(sa_state, images[i], nullptr, nullptr, nullptr, &tickets[i]) == 0)
+                {
+                    submitted[i] = true;
+                }
+                /** [SubmitDet] */
+            }
+        }
+        if (i == 0 || !submitted[i - 1])
+        {
+            continue;
+        }
+
+        // Collect the detection of the previous image and submit classification of its windshields
+        /** [Wait] */
+        SaTaskResult det_task;
+        if (api.saWait(sa_state, tickets[i - 1], -1, &det_task) != 0 || det_task.status != 0)
+        {
+            continue;
+        }
+        /** [Wait] */
+        printf("Image %s - found %d detections\n", TestImageList[i - 1], det_task.det_result.num_detections);
+
+        std::vector<SaTicket> scl_tickets;
+        for (int j = 0; j < det_task.det_result.num_detections; j++)
+        {
+            SaDetection& det = det_task.det_result.detections[j];
+            // Classify only a windshield detections
+            if (std::strncmp((char *)det.label, "window", sizeof("window") - 1) != 0)
+            {
+                continue;
+            }
+            /** [SubmitScl] */
+            SaTicket scl_ticket;
+            if (api.saSubmitScl(sa_state, images[i - 1], &det.position, det.label, nullptr, nullptr, &scl_ticket) == 0)
+            {
+                scl_tickets.push_back(scl_ticket);
+            }
+            /** [SubmitScl] */
+        }
+        api.saFreeDetResult(sa_state, &det_task.det_result);
+
+        // Poll the classification results, other work could be done in between
+        size_t num_collected = 0;
+        std::vector<bool> collected(scl_tickets.size(), false);
+        while (num_collected < scl_tickets.size())
+        {
+            for (size_t k = 0; k < scl_tickets.size(); k++)
+            {
+                if (collected[k])
+                {
+                    continue;
+                }
+                /** [Poll] */
+                SaTaskResult scl_task;
+                int ret = api.saPoll(sa_state, scl_tickets[k], &scl_task);
+                if (ret == SA_RESULT_PENDING)
+                {
+                    continue;
+                }
+                /** [Poll] */
+                collected[k] = true;
+                num_collected += 1;
+                if (ret != 0 || scl_task.status != 0)
+                {
+                    continue;
+                }
+                printf("  - left: %s middle: %s right: %s\n",
+                    scl_task.scl_result.left.occupied.result, scl_task.scl_result.middle.occupied.result, scl_task.scl_result.right.occupied.result);
+            }
+            std::this_thread::yield();
+        }
+    }
+    long long duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+    printf("Pipelined decoding and processing of %d images took %lld ms\n", NUM_IMG, duration);
+
+    // Completion callbacks instead of polling
+    CallbackContext context;
+    context.api = &api;
+    context.sa_state = sa_state;
+    context.num_finished = 0;
+    context.num_detections = 0;
+    int num_submitted = 0;
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        if (images[i].data == nullptr)
+        {
+            continue;
+        }
+        SaTicket ticket;
+        if (api.saSubmitDet(sa_state, images[i], nullptr, onDetFinished, &context, &ticket) == 0)
+        {
+            num_submitted += 1;
+        }
+    }
+    while (context.num_finished < num_submitted)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    printf("Callbacks reported %d detections in %d images\n", (int)context.num_detections, num_submitted);
+
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        if (images[i].data != nullptr)
+        {
+            api.erImageFree(&images[i]);
+        }
+    }
+
+    // Free the SDK state
+    api.saFree(sa_state);
+    return 0;
+}
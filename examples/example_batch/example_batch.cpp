@@ -0,0 +1,285 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//          Seats analyzer library batch example         //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Number of times the whole image list is processed by each method
+#define NUM_ROUNDS 10
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+static void printSpeed(const char *name, unsigned int num_evals, long long duration_us)
+{
+    printf("%s:\n", name);
+    printf("%u evals, %.1f ms\n", num_evals, duration_us / 1000.);
+    printf("Speed: %f ms/eval\n", duration_us / 1000. / (double)num_evals);
+    printf("Speed: %f Hz\n", (double)num_evals / duration_us * 1000000.);
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 1;
+
+    SAState sa_state;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    // Read all input images, the whole list is processed as a single batch
+    std::vector<ERImage> images(NUM_IMG);
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        if (api.erImageRead(&images[i], TestImageList[i]) != 0)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            for (int j = 0; j < i; j++)
+            {
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            return 1;
+        }
+    }
+
+    // Detection results, one per image
+    std::vector<SaDetResult> det_results(NUM_IMG);
+
+    // Looped single-image detection, the same way as in example.cpp
+    long long duration_loop = 0;
+    unsigned int num_loop_evals = 0;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            if (api.saRunDet(sa_state, images[i], nullptr, &det_results[i]) != 0)
+            {
+                continue;
+            }
+            num_loop_evals += 1;
+            api.saFreeDetResult(sa_state, &det_results[i]);
+        }
+        duration_loop += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+    }
+
+    // Batched detection over all images at once
+    long long duration_batch = 0;
+    unsigned int num_batch_evals = 0;
+    bool have_det_results = false;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+        /** [DetBatch] */
+        // Run detection on all images, no RoI is used
+        if (api.saRunDetBatch(sa_state, images.data(), nullptr, NUM_IMG, det_results.data()) != 0)
+        {
+            continue;
+        }
+        /** [DetBatch] */
+        duration_batch += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+        num_batch_evals += NUM_IMG;
+
+        if (r == NUM_ROUNDS - 1)
+        {
+            // Keep the results of the last round for the classification
+            have_det_results = true;
+            break;
+        }
+
+        /** [DetBatchFree] */
+        // Every result of the batch has to be freed
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            api.saFreeDetResult(sa_state, &det_results[i]);
+        }
+        /** [DetBatchFree] */
+    }
+
+    // Collect windshield crops from all images
+    std::vector<int> image_indices;
+    std::vector<ERRotatedRect> positions;
+    std::vector<const char *> labels;
+    if (have_det_results)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            printf("Image %s - found %d detections\n", TestImageList[i], det_results[i].num_detections);
+            for (int j = 0; j < det_results[i].num_detections; j++)
+            {
+                SaDetection& det = det_results[i].detections[j];
+                // Classify only a windshield detections
+                if (std::strncmp((char *)det.label, "window", sizeof("window") - 1) != 0)
+                {
+                    continue;
+                }
+                image_indices.push_back(i);
+                positions.push_back(det.position);
+                labels.push_back(det.label);
+            }
+        }
+    }
+    int num_crops = (int)positions.size();
+    std::vector<SaDetectionLabel> detection_labels(num_crops);
+    for (int k = 0; k < num_crops; k++)
+    {
+        std::strncpy(detection_labels[k], labels[k], SA_LABEL_STRING_LENGTH - 1);
+        detection_labels[k][SA_LABEL_STRING_LENGTH - 1] = '\0';
+    }
+
+    // Looped single-crop classification
+    std::vector<SaSclResult> scl_results(num_crops);
+    long long duration_scl_loop = 0;
+    unsigned int num_scl_loop_evals = 0;
+    for (int r = 0; r < NUM_ROUNDS && num_crops > 0; r++)
+    {
+        std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+        for (int k = 0; k < num_crops; k++)
+        {
+            if (api.saRunScl(sa_state, images[image_indices[k]], &positions[k], detection_labels[k], &scl_results[k]) != 0)
+            {
+                continue;
+            }
+            num_scl_loop_evals += 1;
+        }
+        duration_scl_loop += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+    }
+
+    // Batched classification of all crops at once
+    long long duration_scl_batch = 0;
+    unsigned int num_scl_batch_evals = 0;
+    for (int r = 0; r < NUM_ROUNDS && num_crops > 0; r++)
+    {
+        std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+        /** [SclBatch] */
+        // Run Seat Classification on windshield crops from all images
+        if (api.saRunSclBatch(sa_state, images.data(), NUM_IMG, image_indices.data(), positions.data(),
+                              detection_labels.data(), num_crops, scl_results.data()) != 0)
+        {
+            continue;
+        }
+        /** [SclBatch] */
+        duration_scl_batch += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+        num_scl_batch_evals += num_crops;
+    }
+
+    for (int k = 0; k < num_crops && num_scl_batch_evals > 0; k++)
+    {
+        printf("Image %s - left: %s middle: %s right: %s\n", TestImageList[image_indices[k]],
+            scl_results[k].left.occupied.result, scl_results[k].middle.occupied.result, scl_results[k].right.occupied.result);
+    }
+
+    if (have_det_results)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            api.saFreeDetResult(sa_state, &det_results[i]);
+        }
+    }
+
+    if (num_loop_evals > 0) {
+        printSpeed("Looped detector speed", num_loop_evals, duration_loop);
+    }
+    if (num_batch_evals > 0) {
+        printSpeed("Batched detector speed", num_batch_evals, duration_batch);
+    }
+    if (num_loop_evals > 0 && num_batch_evals > 0 && duration_loop > 0 && duration_batch > 0) {
+        printf("Batch speed-up: %.2fx\n",
+            ((double)num_batch_evals / duration_batch) / ((double)num_loop_evals / duration_loop));
+    }
+
+    if (num_scl_loop_evals > 0) {
+        printSpeed("Looped classifier speed", num_scl_loop_evals, duration_scl_loop);
+    }
+    if (num_scl_batch_evals > 0) {
+        printSpeed("Batched classifier speed", num_scl_batch_evals, duration_scl_batch);
+    }
+    if (num_scl_loop_evals > 0 && num_scl_batch_evals > 0 && duration_scl_loop > 0 && duration_scl_batch > 0) {
+        printf("Batch speed-up: %.2fx\n",
+            ((double)num_scl_batch_evals / duration_scl_batch) / ((double)num_scl_loop_evals / duration_scl_loop));
+    }
+
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        api.erImageFree(&images[i]);
+    }
+
+    // Free the SDK state
+    api.saFree(sa_state);
+    return 0;
+}
@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//     Seats analyzer library result buffers example     //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Number of times the whole image list is processed by each method
+#define NUM_ROUNDS 10
+// Initial capacity of the detection buffer
+#define INITIAL_CAPACITY 4
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+static void printSpeed(const char *name, unsigned int num_evals, long long duration_us)
+{
+    printf("%s:\n", name);
+    printf("%u evals, %.1f ms\n", num_evals, duration_us / 1000.);
+    printf("Speed: %f ms/eval\n", duration_us / 1000. / (double)num_evals);
+    printf("Speed: %f Hz\n", (double)num_evals / duration_us * 1000000.);
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 1;
+
+    SAState sa_state;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    // Read all input images
+    std::vector<ERImage> images(NUM_IMG);
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        if (api.erImageRead(&images[i], TestImageList[i]) != 0)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            for (int j = 0; j < i; j++)
+            {
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            return 1;
+        }
+    }
+
+    // Allocating detection, the result is allocated by the SDK and freed by saFreeDetResult
+    long long duration_alloc = 0;
+    unsigned int num_alloc_evals = 0;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            SaDetResult det_result;
+            if (api.saRunDet(sa_state, images[i], nullptr, &det_result) != 0)
+            {
+                continue;
+            }
+            api.saFreeDetResult(sa_state, &det_result);
+            duration_alloc += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+            num_alloc_evals += 1;
+        }
+    }
+
+    // Detection into a caller-owned buffer, reused for all frames
+    std::vector<SaDetection> detections(INITIAL_CAPACITY);
+    long long duration_into = 0;
+    unsigned int num_into_evals = 0;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            /** [DetInto] */
+            // Run detection into the caller-owned buffer, grow the buffer and repeat if it is too small
+            int num_detections = 0;
+            int ret = api.saRunDetInto(sa_state, images[i], nullptr, detections.data(), (int)detections.size(), &num_detections);
+            if (ret == SA_RESULT_BUFFER_TOO_SMALL)
+            {
+                detections.resize(num_detections);
+                ret = api.saRunDetInto(sa_state, images[i], nullptr, detections.data(), (int)detections.size(), &num_detections);
+            }
+            if (ret != 0)
+            {
+                continue;
+            }
+            /** [DetInto] */
+            duration_into += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+            num_into_evals += 1;
+
+            if (r == NUM_ROUNDS - 1)
+            {
+                printf("Image %s - found %d detections\n", TestImageList[i], num_detections);
+            }
+        }
+    }
+
+    if (num_alloc_evals > 0) {
+        printSpeed("Allocating detector speed", num_alloc_evals, duration_alloc);
+    }
+    if (num_into_evals > 0) {
+        printSpeed("Caller-owned buffer detector speed", num_into_evals, duration_into);
+        printf("Final buffer capacity: %u detections\n", (unsigned int)detections.size());
+    }
+
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        api.erImageFree(&images[i]);
+    }
+
+    // Free the SDK state
+    api.saFree(sa_state);
+    return 0;
+}
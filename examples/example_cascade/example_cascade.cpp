@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//        Seats analyzer library cascade example         //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Number of times all windshields are classified with each configuration
+#define NUM_ROUNDS 10
+// Cascade thresholds
+#define MIN_QUALITY 0.3f
+#define MIN_OCCUPIED_CONFIDENCE 0.5f
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 1;
+
+    SAState sa_state;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    /** [CascadeConfig] */
+    // Second state with the cascade enabled, initialized separately and never cloned, so its cascade counters
+    // cover exactly the classifications run on it below
+    config.scl_cascade = 1;
+    config.scl_cascade_min_quality = MIN_QUALITY;
+    config.scl_cascade_min_occupied_confidence = MIN_OCCUPIED_CONFIDENCE;
+    SAState sa_state_cascade;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state_cascade) != 0)
+    {
+        api.saFree(sa_state);
+        return 1;
+    }
+    /** [CascadeConfig] */
+
+    // Read all input images
+    std::vector<ERImage> images(NUM_IMG);
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        if (api.erImageRead(&images[i], TestImageList[i]) != 0)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            for (int j = 0; j < i; j++)
+            {
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            api.saFree(sa_state_cascade);
+            return 1;
+        }
+    }
+
+    // Detect windshields once, only the classification is measured
+    std::vector<int> image_indices;
+    std::vector<SaDetection> windows;
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        SaDetResult det_result;
+        if (api.saRunDet(sa_state, images[i], nullptr, &det_result) != 0)
+        {
+            continue;
+        }
+        for (int j = 0; j < det_result.num_detections; j++)
+        {
+            SaDetection& det = det_result.detections[j];
+            // Classify only a windshield detections
+            if (std::strncmp((char *)det.label, "window", sizeof("window") - 1) != 0)
+            {
+                continue;
+            }
+            image_indices.push_back(i);
+            windows.push_back(det);
+        }
+        api.saFreeDetResult(sa_state, &det_result);
+    }
+    printf("Found %u windshields\n", (unsigned int)windows.size());
+
+    // Classify all windshields without and with the cascade
+    SAState states[2] = { sa_state, sa_state_cascade };
+    const char *names[2] = { "Full classification", "Cascade classification" };
+    for (int s = 0; s < 2 && !windows.empty(); s++)
+    {
+        long long duration = 0;
+        unsigned int num_evals = 0;
+        for (int r = 0; r < NUM_ROUNDS; r++)
+        {
+            for (size_t k = 0; k < windows.size(); k++)
+            {
+                std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+                SaSclResult scl_result;
+                if (api.saRunScl(states[s], images[image_indices[k]], &windows[k].position, windows[k].label, &scl_result) != 0)
+                {
+                    continue;
+                }
+                duration += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+                num_evals += 1;
+            }
+        }
+        if (num_evals > 0)
+        {
+            printf("%s: %u evals, %f ms/eval\n", names[s], num_evals, duration / 1000. / (double)num_evals);
+        }
+    }
+
+    /** [CascadeStats] */
+    // Print how much work the cascade saved, the counters of sa_state_cascade and its clones (none here)
+    SaCascadeStats stats;
+    if (api.saGetCascadeStats(sa_state_cascade, &stats) == 0)
+    {
+        printf("Cascade: %llu positions, %llu skipped for low quality, %llu skipped as unoccupied\n",
+            stats.positions, stats.skipped_low_quality, stats.skipped_unoccupied);
+        printf(" driver %llu computed / %llu skipped, belt %llu / %llu, phone %llu / %llu\n",
+            stats.driver_computed, stats.driver_skipped,
+            stats.belt_computed, stats.belt_skipped,
+            stats.phone_computed, stats.phone_skipped);
+    }
+    /** [CascadeStats] */
+
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        api.erImageFree(&images[i]);
+    }
+
+    // Free the SDK states
+    api.saFree(sa_state_cascade);
+    api.saFree(sa_state);
+    return 0;
+}
@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//    Seats analyzer library compact results example     //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Capacity of the detection buffer
+#define MAX_DETECTIONS 16
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+// Converts compact classification result to the character used by SaClass.result
+static char classResultChar(const SaCompactClass &sa_class)
+{
+    switch (sa_class.result)
+    {
+    case SA_CLASS_FALSE:   return '0';
+    case SA_CLASS_TRUE:    return '1';
+    case SA_CLASS_UNKNOWN: return '?';
+    default:               return '-';
+    }
+}
+
+static void printPosition(const char *name, const SaCompactPosition &position)
+{
+    printf("  - %-7s %c (%.2f) quality %.2f driver %c (%.2f) belt %c (%.2f) phone %c (%.2f)\n", name,
+        classResultChar(position.occupied), position.occupied.confidence,
+        position.quality,
+        classResultChar(position.driver), position.driver.confidence,
+        classResultChar(position.belt), position.belt.confidence,
+        classResultChar(position.phone), position.phone.confidence);
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 1;
+
+    SAState sa_state;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    // Read all input images
+    std::vector<ERImage> images(NUM_IMG);
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        if (api.erImageRead(&images[i], TestImageList[i]) != 0)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            for (int j = 0; j < i; j++)
+            {
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            return 1;
+        }
+    }
+
+    printf("Result sizes: SaDetection %u B, SaCompactDetection %u B, SaSclResult %u B, SaCompactSclResult %u B\n",
+        (unsigned int)sizeof(SaDetection), (unsigned int)sizeof(SaCompactDetection),
+        (unsigned int)sizeof(SaSclResult), (unsigned int)sizeof(SaCompactSclResult));
+
+    SaCompactDetection detections[MAX_DETECTIONS];
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        /** [DetCompact] */
+        // Run detection, at most MAX_DETECTIONS detections are returned
+        int num_detections = 0;
+        int ret = api.saRunDetCompact(sa_state, images[i], nullptr, detections, MAX_DETECTIONS, &num_detections);
+        if (ret != 0 && ret != SA_RESULT_BUFFER_TOO_SMALL)
+        {
+            continue;
+        }
+        if (num_detections > MAX_DETECTIONS)
+        {
+            num_detections = MAX_DETECTIONS;
+        }
+        /** [DetCompact] */
+
+        // Numeric label of windshield detections, the ids change when the models are reloaded so they are not cached
+        SaLabelId window_id = api.saGetLabelId(sa_state, "window");
+
+        printf("Image %s - found %d detections\n", TestImageList[i], num_detections);
+        for (int j = 0; j < num_detections; j++)
+        {
+            SaCompactDetection& det = detections[j];
+            const char *label = api.saGetLabelName(sa_state, det.label_id);
+            printf(" %d. detection: [%.1fx%.1f at (%.1f,%.1f)], label %s (%.2f)\n",
+                j,
+                det.position.width, det.position.height, det.position.x, det.position.y,
+                label != nullptr ? label : "?", det.confidence);
+
+            // Classify only a windshield detections
+            if (det.label_id != window_id)
+            {
+                continue;
+            }
+
+            /** [SclCompact] */
+            SaCompactSclResult scl_result;
+            if (api.saRunSclCompact(sa_state, images[i], &det.position, det.label_id, &scl_result) != 0)
+            {
+                continue;
+            }
+            /** [SclCompact] */
+            printPosition("left:", scl_result.left);
+            printPosition("middle:", scl_result.middle);
+            printPosition("right:", scl_result.right);
+        }
+    }
+
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        api.erImageFree(&images[i]);
+    }
+
+    // Free the SDK state
+    api.saFree(sa_state);
+    return 0;
+}
@@ -0,0 +1,326 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//      Seats analyzer library crop kernel example       //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Number of classifications of every crop
+#define NUM_ROUNDS 20
+// Maximal difference of qualities and confidences of a SIMD kernel result from the scalar one
+#define CONFIDENCE_TOLERANCE 0.02
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+// A windshield crop of one test image
+struct Crop
+{
+    int              image_index;
+    ERRotatedRect    position;
+    SaDetectionLabel label;
+};
+
+// Converts a BGR image to the given color model, gray by the BT.601 luma weights, BGRA with opaque alpha
+static int convertImage(const SaAPI &api, const ERImage &bgr, ERImageColorModel color_model, ERImage *converted)
+{
+    if (api.erImageAllocate(converted, bgr.width, bgr.height, color_model, ER_IMAGE_DATATYPE_UCHAR) != 0)
+    {
+        return 1;
+    }
+    for (unsigned int y = 0; y < bgr.height; y++)
+    {
+        const unsigned char *src = bgr.row_data[y];
+        unsigned char *dst = converted->row_data[y];
+        for (unsigned int x = 0; x < bgr.width; x++)
+        {
+            const unsigned char *p = src + 3 * x;
+            if (color_model == ER_IMAGE_COLORMODEL_GRAY)
+            {
+                dst[x] = (unsigned char)((29 * p[0] + 150 * p[1] + 77 * p[2] + 128) >> 8);
+            }
+            else
+            {
+                dst[4 * x + 0] = p[0];
+                dst[4 * x + 1] = p[1];
+                dst[4 * x + 2] = p[2];
+                dst[4 * x + 3] = 255;
+            }
+        }
+    }
+    return 0;
+}
+
+// Returns true if the classification matches the reference one, the results exactly and the qualities and
+// confidences within CONFIDENCE_TOLERANCE
+static bool isSameResult(const SaSclResult &result, const SaSclResult &reference)
+{
+    const SaPosition *positions[3] = {&result.left, &result.middle, &result.right};
+    const SaPosition *reference_positions[3] = {&reference.left, &reference.middle, &reference.right};
+    for (int p = 0; p < 3; p++)
+    {
+        if (std::fabs(positions[p]->quality - reference_positions[p]->quality) > CONFIDENCE_TOLERANCE)
+        {
+            return false;
+        }
+        const SaClass *tasks[4] = {&positions[p]->occupied, &positions[p]->driver, &positions[p]->belt, &positions[p]->phone};
+        const SaClass *reference_tasks[4] = {&reference_positions[p]->occupied, &reference_positions[p]->driver,
+                                             &reference_positions[p]->belt, &reference_positions[p]->phone};
+        for (int t = 0; t < 4; t++)
+        {
+            if (std::strcmp(tasks[t]->result, reference_tasks[t]->result) != 0 ||
+                std::fabs(tasks[t]->confidence - reference_tasks[t]->confidence) > CONFIDENCE_TOLERANCE)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Classifies all crops of the images NUM_ROUNDS times and prints the crop stage latency. The results of the first
+// round are stored to an empty reference, or compared with it otherwise. Returns the number of failed or
+// mismatching classifications.
+static int measureCrop(const SaAPI &api, SAState sa_state, const std::vector<ERImage> &images,
+                       const std::vector<Crop> &crops, const char *dispatch_name, const char *color_model_name,
+                       std::vector<SaSclResult> *reference)
+{
+    int num_failures = 0;
+    bool record = reference->empty();
+    api.saResetStats(sa_state);
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (size_t k = 0; k < crops.size(); k++)
+        {
+            SaSclResult scl_result;
+            // The occupancy task only, the crop is the same for all tasks
+            if (api.saRunSclMasked(sa_state, images[crops[k].image_index], &crops[k].position, crops[k].label,
+                                   SA_SCL_ALL_POSITIONS(SA_SCL_TASK_OCCUPIED), &scl_result) != 0)
+            {
+                printf(" %-7s %-5s crop %zu: classification failed\n", dispatch_name, color_model_name, k);
+                num_failures++;
+                if (record && r == 0)
+                {
+                    std::memset(&scl_result, 0, sizeof(SaSclResult));
+                    reference->push_back(scl_result);
+                }
+                continue;
+            }
+            if (r > 0)
+            {
+                continue;
+            }
+            if (record)
+            {
+                reference->push_back(scl_result);
+            }
+            else if (!isSameResult(scl_result, (*reference)[k]))
+            {
+                printf(" %-7s %-5s crop %zu: result differs from the scalar kernels\n", dispatch_name, color_model_name, k);
+                num_failures++;
+            }
+        }
+    }
+    SaStats stats;
+    if (api.saGetStats(sa_state, &stats) != 0)
+    {
+        return num_failures;
+    }
+    const SaStageStats &crop = stats.stages[SA_STAGE_SCL_CROP];
+    printf(" %-7s %-5s %6llu crops, mean %.3f ms, p50 %.3f ms, p99 %.3f ms\n", dispatch_name, color_model_name,
+        crop.count, crop.count > 0 ? crop.total_ms / crop.count : 0., crop.p50_ms, crop.p99_ms);
+    return num_failures;
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+
+    // Initialize one state per kernel instruction set, the unsupported ones are skipped
+    const SaCpuDispatch dispatches[] = {SA_CPU_DISPATCH_SCALAR, SA_CPU_DISPATCH_SSE4, SA_CPU_DISPATCH_AVX2, SA_CPU_DISPATCH_AUTO};
+    const char *dispatch_names[] = {"scalar", "sse4", "avx2", "auto"};
+    const int num_dispatches = sizeof(dispatches) / sizeof(dispatches[0]);
+    std::vector<SAState> states(num_dispatches, nullptr);
+    for (int d = 0; d < num_dispatches; d++)
+    {
+        SaConfig config={};
+        std::memset(&config,0,sizeof(SaConfig));
+        config.struct_size = sizeof(SaConfig);
+        config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+        config.gpu_device_id = 0;
+        config.num_threads = 1;
+        /** [CpuDispatch] */
+        // Select the instruction set of the image kernels, SA_CPU_DISPATCH_AUTO detects the best one
+        config.cpu_dispatch = dispatches[d];
+        /** [CpuDispatch] */
+        if (api.saInit(CONFIG_FILENAME, &config, &states[d]) != 0)
+        {
+            printf("Kernels %s not supported\n", dispatch_names[d]);
+            states[d] = nullptr;
+        }
+    }
+    if (states[0] == nullptr)
+    {
+        for (int d = 1; d < num_dispatches; d++)
+        {
+            if (states[d] != nullptr)
+            {
+                api.saFree(states[d]);
+            }
+        }
+        return 1;
+    }
+
+    // Read the input images and collect the windshield crops using the reference kernels
+    std::vector<ERImage> images;
+    std::vector<Crop> crops;
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        ERImage image;
+        if (api.erImageRead(&image, TestImageList[i]) != 0)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            continue;
+        }
+        SaDetResult det_result;
+        if (api.saRunDet(states[0], image, nullptr, &det_result) != 0)
+        {
+            api.erImageFree(&image);
+            continue;
+        }
+        for (int j = 0; j < det_result.num_detections; j++)
+        {
+            SaDetection& det = det_result.detections[j];
+            // Classify only a windshield detections
+            if (std::strncmp((char *)det.label, "window", sizeof("window") - 1) != 0)
+            {
+                continue;
+            }
+            Crop crop;
+            crop.image_index = (int)images.size();
+            crop.position = det.position;
+            std::strncpy(crop.label, det.label, SA_LABEL_STRING_LENGTH - 1);
+            crop.label[SA_LABEL_STRING_LENGTH - 1] = '\0';
+            crops.push_back(crop);
+            // The same crop rotated, the detected windshields are mostly up-right
+            crop.position.angle += 15.f;
+            crops.push_back(crop);
+        }
+        api.saFreeDetResult(states[0], &det_result);
+        images.push_back(image);
+    }
+
+    // Gray and BGRA copies of the images
+    std::vector<ERImage> gray_images(images.size());
+    std::vector<ERImage> bgra_images(images.size());
+    bool converted = true;
+    for (size_t i = 0; i < images.size() && converted; i++)
+    {
+        converted = convertImage(api, images[i], ER_IMAGE_COLORMODEL_GRAY, &gray_images[i]) == 0 &&
+                    convertImage(api, images[i], ER_IMAGE_COLORMODEL_BGRA, &bgra_images[i]) == 0;
+    }
+
+    // Results of the scalar kernels, the first state, every other kernel set is compared with them
+    std::vector<SaSclResult> bgr_reference, bgra_reference, gray_reference;
+    int num_failures = 0;
+    if (!crops.empty() && converted)
+    {
+        printf("Classification crop stage, %zu crops x %d rounds:\n", crops.size(), NUM_ROUNDS);
+        for (int d = 0; d < num_dispatches; d++)
+        {
+            if (states[d] == nullptr)
+            {
+                continue;
+            }
+            num_failures += measureCrop(api, states[d], images, crops, dispatch_names[d], "bgr", &bgr_reference);
+            num_failures += measureCrop(api, states[d], bgra_images, crops, dispatch_names[d], "bgra", &bgra_reference);
+            num_failures += measureCrop(api, states[d], gray_images, crops, dispatch_names[d], "gray", &gray_reference);
+        }
+        if (num_failures == 0)
+        {
+            printf("PASSED\n");
+        }
+        else
+        {
+            printf("FAILED: %d classifications failed or differ from the scalar kernels\n", num_failures);
+        }
+    }
+
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        api.erImageFree(&images[i]);
+        api.erImageFree(&gray_images[i]);
+        api.erImageFree(&bgra_images[i]);
+    }
+
+    // Free the SDK states
+    for (int d = 0; d < num_dispatches; d++)
+    {
+        if (states[d] != nullptr)
+        {
+            api.saFree(states[d]);
+        }
+    }
+    return num_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//         Seats analyzer library decode example         //
+///////////////////////////////////////////////////////////
+
+// Usage: example_decode [scale_denom]
+// Compares decoding of the test images downscaled by 1/scale_denom (2, 4 or 8, default 4):
+//  - erImageRead and a separate resize
+//  - erImageReadFromMemory in full resolution and a separate resize
+//  - erImageReadFromMemory with DCT domain downscaling into a pooled ERImage
+
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <chrono>
+#include <vector>
+
+#ifndef _WIN32
+#   include <sys/resource.h>
+#endif
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Number of times the whole image list is decoded by each method
+#define NUM_ROUNDS 10
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+// Returns the peak resident set size of the process in kilobytes, zero if not available
+static long long peakRssKb()
+{
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? (long long)usage.ru_maxrss : 0;
+#endif
+}
+
+// Downscales an uchar image by averaging scale x scale blocks, the way a caller resizes after a full decode
+static int resizeImage(const SaAPI &api, const ERImage &image, unsigned int scale, ERImage *resized)
+{
+    unsigned int width = (image.width + scale - 1) / scale;
+    unsigned int height = (image.height + scale - 1) / scale;
+    if (api.erImageAllocate(resized, width, height, image.color_model, ER_IMAGE_DATATYPE_UCHAR) != 0)
+    {
+        return 1;
+    }
+    unsigned int num_channels = image.num_channels;
+    for (unsigned int y = 0; y < height; y++)
+    {
+        for (unsigned int x = 0; x < width; x++)
+        {
+            for (unsigned int c = 0; c < num_channels; c++)
+            {
+                unsigned int sum = 0, count = 0;
+                for (unsigned int sy = y * scale; sy < (y + 1) * scale && sy < image.height; sy++)
+                {
+                    for (unsigned int sx = x * scale; sx < (x + 1) * scale && sx < image.width; sx++)
+                    {
+                        sum += image.row_data[sy][sx * num_channels + c];
+                        count++;
+                    }
+                }
+                resized->row_data[y][x * num_channels + c] = (unsigned char)(sum / count);
+            }
+        }
+    }
+    return 0;
+}
+
+static void printResult(const char *name, unsigned int num_frames, long long duration_us, unsigned long long bytes)
+{
+    printf("%s:\n", name);
+    printf(" %u frames, %f ms/frame, %llu bytes of image data/frame, peak RSS %lld kB\n",
+        num_frames, duration_us / 1000. / num_frames, bytes / num_frames, peakRssKb());
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int scale = argc > 1 ? (unsigned int)std::atoi(argv[1]) : 4;
+    if (scale != 2 && scale != 4 && scale != 8)
+    {
+        std::cerr << "Scale denominator must be 2, 4 or 8" << std::endl;
+        return 1;
+    }
+
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+
+    // Encoded images as received e.g. over network
+    std::vector<std::vector<unsigned char> > encoded(NUM_IMG);
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        std::ifstream file(TestImageList[i], std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            return 1;
+        }
+        encoded[i].assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    unsigned int num_frames = NUM_ROUNDS * NUM_IMG;
+
+    // The methods are run from the least memory demanding one, the peak RSS only grows
+    // One pooled image for all frames, its data are reused once large enough
+    ERImage pooled;
+    std::memset(&pooled, 0, sizeof(ERImage));
+    bool pooled_valid = false;
+    long long duration = 0;
+    unsigned long long bytes = 0;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            /** [ReadFromMemory] */
+            // Decode the JPEG downscaled in DCT domain, directly into the pooled image
+            if (api.erImageReadFromMemory(&pooled, encoded[i].data(), encoded[i].size(), scale,
+                                          pooled_valid ? ER_IMAGE_READ_REUSE : 0) != 0)
+            {
+                continue;
+            }
+            pooled_valid = true;
+            /** [ReadFromMemory] */
+            duration += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+            bytes += pooled.size;
+        }
+    }
+    printResult("erImageReadFromMemory with DCT downscale", num_frames, duration, bytes);
+    if (pooled_valid)
+    {
+        api.erImageFree(&pooled);
+    }
+
+    duration = 0;
+    bytes = 0;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            ERImage image, resized;
+            if (api.erImageReadFromMemory(&image, encoded[i].data(), encoded[i].size(), 1, 0) != 0)
+            {
+                continue;
+            }
+            if (resizeImage(api, image, scale, &resized) == 0)
+            {
+                bytes += image.size + resized.size;
+                api.erImageFree(&resized);
+            }
+            api.erImageFree(&image);
+            duration += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+        }
+    }
+    printResult("erImageReadFromMemory and resize", num_frames, duration, bytes);
+
+    duration = 0;
+    bytes = 0;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            ERImage image, resized;
+            if (api.erImageRead(&image, TestImageList[i]) != 0)
+            {
+                continue;
+            }
+            if (resizeImage(api, image, scale, &resized) == 0)
+            {
+                bytes += image.size + resized.size;
+                api.erImageFree(&resized);
+            }
+            api.erImageFree(&image);
+            duration += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+        }
+    }
+    printResult("erImageRead and resize", num_frames, duration, bytes);
+
+    return 0;
+}
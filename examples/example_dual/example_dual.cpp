@@ -0,0 +1,287 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//     Seats analyzer library dual resolution example    //
+///////////////////////////////////////////////////////////
+
+// Detection runs on a quarter-resolution preview of each frame, the way a camera sub-stream would be used,
+// classification on the full-resolution frame. Compares:
+//  - saRunDetScl on the full-resolution frame
+//  - saRunDetSclDual on the preview and the full-resolution frame
+//  - saRunDet on the preview, the full-resolution frame decoded only when a windshield is present
+
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Number of times the whole image list is processed by each method
+#define NUM_ROUNDS 10
+
+// Downscale of the preview images
+#define PREVIEW_SCALE 4
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+static void printLatency(const char *name, std::vector<long long> &latencies_us)
+{
+    if (latencies_us.empty())
+    {
+        return;
+    }
+    long long total_us = 0;
+    for (size_t i = 0; i < latencies_us.size(); i++)
+    {
+        total_us += latencies_us[i];
+    }
+    std::sort(latencies_us.begin(), latencies_us.end());
+    printf("%s:\n", name);
+    printf("%u frames, %.1f ms\n", (unsigned int)latencies_us.size(), total_us / 1000.);
+    printf("Mean latency: %f ms/frame\n", total_us / 1000. / (double)latencies_us.size());
+    printf("Median latency: %f ms/frame\n", latencies_us[latencies_us.size() / 2] / 1000.);
+    printf("Max latency: %f ms/frame\n", latencies_us.back() / 1000.);
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 1;
+
+    SAState sa_state;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    // Encoded frames, the previews and the full-resolution images are decoded from the same data
+    std::vector<std::vector<unsigned char> > encoded(NUM_IMG);
+    std::vector<ERImage> previews(NUM_IMG);
+    std::vector<ERImage> images(NUM_IMG);
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        std::ifstream file(TestImageList[i], std::ios::binary);
+        encoded[i].assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (!file || api.erImageReadFromMemory(&previews[i], encoded[i].data(), encoded[i].size(), PREVIEW_SCALE, 0) != 0)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            for (int j = 0; j < i; j++)
+            {
+                api.erImageFree(&previews[j]);
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            return 1;
+        }
+        if (api.erImageReadFromMemory(&images[i], encoded[i].data(), encoded[i].size(), 1, 0) != 0)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            api.erImageFree(&previews[i]);
+            for (int j = 0; j < i; j++)
+            {
+                api.erImageFree(&previews[j]);
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            return 1;
+        }
+    }
+
+    // Full-resolution frame for both stages
+    std::vector<long long> latencies_full;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            SaFullResult full_result;
+            if (api.saRunDetScl(sa_state, images[i], nullptr, &full_result) != 0)
+            {
+                continue;
+            }
+            latencies_full.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count());
+            api.saFreeFullResult(sa_state, &full_result);
+        }
+    }
+
+    // Preview for detection, full-resolution frame for classification
+    std::vector<long long> latencies_dual;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            /** [DetSclDual] */
+            // The mapping is derived from the image sizes, pass SaScaleMapping if the preview is cropped
+            SaFullResult full_result;
+            if (api.saRunDetSclDual(sa_state, previews[i], images[i], nullptr, nullptr, &full_result) != 0)
+            {
+                continue;
+            }
+            /** [DetSclDual] */
+            latencies_dual.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count());
+
+            if (r == NUM_ROUNDS - 1)
+            {
+                printf("Image %s - found %d detections\n", TestImageList[i], full_result.num_detections);
+                for (int j = 0; j < full_result.num_detections; j++)
+                {
+                    SaFullDetection& det = full_result.detections[j];
+                    printf(" %d. detection: [%.1fx%.1f at (%.1f,%.1f)], label %s (%.2f)\n",
+                        j,
+                        det.detection.position.width, det.detection.position.height, det.detection.position.x, det.detection.position.y,
+                        det.detection.label, det.detection.confidence);
+                    if (!det.has_scl)
+                    {
+                        continue;
+                    }
+                    printf("  - left: %s middle: %s right: %s\n",
+                        det.scl_result.left.occupied.result, det.scl_result.middle.occupied.result, det.scl_result.right.occupied.result);
+                }
+            }
+            api.saFreeFullResult(sa_state, &full_result);
+        }
+    }
+
+    // Detection on the preview, the full-resolution frame is decoded only for frames with a windshield
+    std::vector<long long> latencies_lazy;
+    unsigned int num_decoded = 0;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            SaDetResult det_result;
+            if (api.saRunDet(sa_state, previews[i], nullptr, &det_result) != 0)
+            {
+                continue;
+            }
+            SaScaleMapping mapping;
+            ERImage image;
+            bool decoded = false;
+            for (int j = 0; j < det_result.num_detections; j++)
+            {
+                SaDetection& det = det_result.detections[j];
+                // Classify only a windshield detections
+                if (std::strncmp((char *)det.label, "window", sizeof("window") - 1) != 0)
+                {
+                    continue;
+                }
+                if (!decoded)
+                {
+                    if (api.erImageReadFromMemory(&image, encoded[i].data(), encoded[i].size(), 1, 0) != 0)
+                    {
+                        break;
+                    }
+                    decoded = true;
+                    num_decoded++;
+                    mapping.scale_x = (float)image.width / previews[i].width;
+                    mapping.scale_y = (float)image.height / previews[i].height;
+                    mapping.offset_x = 0.f;
+                    mapping.offset_y = 0.f;
+                }
+                /** [MapRotatedRect] */
+                // Map the preview position to the full-resolution frame
+                ERRotatedRect position;
+                if (api.saMapRotatedRect(&mapping, &det.position, 0, &position) != 0)
+                {
+                    continue;
+                }
+                SaSclResult scl_result;
+                api.saRunScl(sa_state, image, &position, det.label, &scl_result);
+                /** [MapRotatedRect] */
+            }
+            api.saFreeDetResult(sa_state, &det_result);
+            if (decoded)
+            {
+                api.erImageFree(&image);
+            }
+            latencies_lazy.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count());
+        }
+    }
+
+    printLatency("Full-resolution latency (saRunDetScl)", latencies_full);
+    printLatency("Dual-resolution latency (saRunDetSclDual)", latencies_dual);
+    printLatency("On-demand decode latency (saRunDet + saMapRotatedRect + saRunScl)", latencies_lazy);
+    printf("Full-resolution frames decoded on demand: %u of %u\n", num_decoded, (unsigned int)latencies_lazy.size());
+
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        api.erImageFree(&previews[i]);
+        api.erImageFree(&images[i]);
+    }
+
+    // Free the SDK state
+    api.saFree(sa_state);
+    return 0;
+}
@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//          Seats analyzer library fused example         //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Number of times the whole image list is processed by each method
+#define NUM_ROUNDS 10
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+static void printLatency(const char *name, std::vector<long long> &latencies_us)
+{
+    if (latencies_us.empty())
+    {
+        return;
+    }
+    long long total_us = 0;
+    for (size_t i = 0; i < latencies_us.size(); i++)
+    {
+        total_us += latencies_us[i];
+    }
+    std::sort(latencies_us.begin(), latencies_us.end());
+    printf("%s:\n", name);
+    printf("%u frames, %.1f ms\n", (unsigned int)latencies_us.size(), total_us / 1000.);
+    printf("Mean latency: %f ms/frame\n", total_us / 1000. / (double)latencies_us.size());
+    printf("Median latency: %f ms/frame\n", latencies_us[latencies_us.size() / 2] / 1000.);
+    printf("Max latency: %f ms/frame\n", latencies_us.back() / 1000.);
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 1;
+
+    SAState sa_state;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    // Read all input images, decoding is not part of the measured latency
+    std::vector<ERImage> images(NUM_IMG);
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        if (api.erImageRead(&images[i], TestImageList[i]) != 0)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            for (int j = 0; j < i; j++)
+            {
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            return 1;
+        }
+    }
+
+    // Two-call sequence, the same way as in example.cpp
+    std::vector<long long> latencies_two_call;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            SaDetResult det_result;
+            if (api.saRunDet(sa_state, images[i], nullptr, &det_result) != 0)
+            {
+                continue;
+            }
+            for (int j = 0; j < det_result.num_detections; j++)
+            {
+                SaDetection& det = det_result.detections[j];
+                // Classify only a windshield detections
+                if (std::strncmp((char *)det.label, "window", sizeof("window") - 1) != 0)
+                {
+                    continue;
+                }
+                SaSclResult scl_result;
+                api.saRunScl(sa_state, images[i], &det.position, det.label, &scl_result);
+            }
+            api.saFreeDetResult(sa_state, &det_result);
+            latencies_two_call.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count());
+        }
+    }
+
+    // Fused detection and classification
+    std::vector<long long> latencies_fused;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            /** [DetScl] */
+            // Run detection and classification of all windshield detections
+            SaFullResult full_result;
+            if (api.saRunDetScl(sa_state, images[i], nullptr, &full_result) != 0)
+            {
+                continue;
+            }
+            /** [DetScl] */
+            latencies_fused.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count());
+
+            if (r == NUM_ROUNDS - 1)
+            {
+                printf("Image %s - found %d detections\n", TestImageList[i], full_result.num_detections);
+                for (int j = 0; j < full_result.num_detections; j++)
+                {
+                    SaFullDetection& det = full_result.detections[j];
+                    printf(" %d. detection: [%.1fx%.1f at (%.1f,%.1f)], label %s (%.2f)\n",
+                        j,
+                        det.detection.position.width, det.detection.position.height, det.detection.position.x, det.detection.position.y,
+                        det.detection.label, det.detection.confidence);
+                    if (!det.has_scl)
+                    {
+                        continue;
+                    }
+                    printf("  - left: %s middle: %s right: %s\n",
+                        det.scl_result.left.occupied.result, det.scl_result.middle.occupied.result, det.scl_result.right.occupied.result);
+                }
+            }
+
+            /** [DetSclFree] */
+            // Free the detection and classification results
+            api.saFreeFullResult(sa_state, &full_result);
+            /** [DetSclFree] */
+        }
+    }
+
+    printLatency("Two-call latency (saRunDet + saRunScl)", latencies_two_call);
+    printLatency("Fused latency (saRunDetScl)", latencies_fused);
+
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        api.erImageFree(&images[i]);
+    }
+
+    // Free the SDK state
+    api.saFree(sa_state);
+    return 0;
+}
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//          Seats analyzer library init example          //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+
+// Initializes the library with the given model loading mode and prints the timing breakdown
+static int measureInit(const SaAPI &api, SaModelLoadMode model_load_mode, const char *name)
+{
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 1;
+    config.model_load_mode = model_load_mode;
+
+    SAState sa_state;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    /** [InitTiming] */
+    SaInitTiming timing;
+    if (api.saGetInitTiming(sa_state, &timing) == 0)
+    {
+        printf("%s: total %.1f ms (config %.1f ms, detector %.1f ms%s, classifier %.1f ms%s, p-table %.1f ms, warm-up %.1f ms)\n",
+            name, timing.total_ms, timing.config_ms,
+            timing.det_plugin_ms, timing.det_mapped ? " mapped" : "",
+            timing.scl_model_ms, timing.scl_mapped ? " mapped" : "",
+            timing.p_table_ms, timing.warmup_ms);
+    }
+    /** [InitTiming] */
+
+    api.saFree(sa_state);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // The first call of each mode may hit cold page cache, the second one is a warm start
+    const char *names[2][2] = { { "Heap, first", "Heap, second" }, { "Mmap, first", "Mmap, second" } };
+    SaModelLoadMode modes[2] = { SA_MODEL_LOAD_HEAP, SA_MODEL_LOAD_MMAP };
+    for (int m = 0; m < 2; m++)
+    {
+        for (int r = 0; r < 2; r++)
+        {
+            if (measureInit(api, modes[m], names[m][r]) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,277 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//          Seats analyzer library NV12 example          //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Number of times the whole image list is processed by each method
+#define NUM_ROUNDS 10
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+static void printSpeed(const char *name, unsigned int num_evals, long long duration_us)
+{
+    printf("%s:\n", name);
+    printf("%u evals, %.1f ms\n", num_evals, duration_us / 1000.);
+    printf("Speed: %f ms/eval\n", duration_us / 1000. / (double)num_evals);
+    printf("Speed: %f Hz\n", (double)num_evals / duration_us * 1000000.);
+}
+
+static unsigned char clampByte(int value)
+{
+    return (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// Converts BGR image to NV12, simulates the output of a camera or a hardware decoder
+static int bgrToNv12(const SaAPI &api, const ERImage &bgr, ERImage *nv12)
+{
+    unsigned int width = bgr.width & ~1u;
+    unsigned int height = bgr.height & ~1u;
+    if (api.erImageAllocate(nv12, width, height, ER_IMAGE_COLORMODEL_YCBCRNV12, ER_IMAGE_DATATYPE_UCHAR) != 0)
+    {
+        return 1;
+    }
+    unsigned char *uv_plane = nv12->data + nv12->step * height;
+    for (unsigned int y = 0; y < height; y++)
+    {
+        const unsigned char *src = bgr.data + bgr.step * y;
+        unsigned char *dst_y = nv12->data + nv12->step * y;
+        unsigned char *dst_uv = uv_plane + nv12->step * (y / 2);
+        for (unsigned int x = 0; x < width; x++)
+        {
+            int b = src[3 * x], g = src[3 * x + 1], r = src[3 * x + 2];
+            dst_y[x] = clampByte(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            if ((y & 1) == 0 && (x & 1) == 0)
+            {
+                dst_uv[x] = clampByte(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+                dst_uv[x + 1] = clampByte(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+            }
+        }
+    }
+    return 0;
+}
+
+// Converts NV12 image to a full-resolution BGR image, the way frames are prepared for saRunDet without native NV12 support
+static void nv12ToBgr(const ERImage &nv12, ERImage *bgr)
+{
+    const unsigned char *uv_plane = nv12.data + nv12.step * nv12.height;
+    for (unsigned int y = 0; y < nv12.height; y++)
+    {
+        const unsigned char *src_y = nv12.data + nv12.step * y;
+        const unsigned char *src_uv = uv_plane + nv12.step * (y / 2);
+        unsigned char *dst = bgr->data + bgr->step * y;
+        for (unsigned int x = 0; x < nv12.width; x++)
+        {
+            int c = 298 * (src_y[x] - 16);
+            int d = src_uv[x & ~1u] - 128;
+            int e = src_uv[(x & ~1u) + 1] - 128;
+            dst[3 * x] = clampByte((c + 516 * d + 128) >> 8);
+            dst[3 * x + 1] = clampByte((c - 100 * d - 208 * e + 128) >> 8);
+            dst[3 * x + 2] = clampByte((c + 409 * e + 128) >> 8);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 1;
+
+    SAState sa_state;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    // Read all input images and convert them to NV12
+    std::vector<ERImage> images(NUM_IMG);
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        ERImage bgr_image;
+        if (api.erImageRead(&bgr_image, TestImageList[i]) != 0 || bgr_image.color_model != ER_IMAGE_COLORMODEL_BGR)
+        {
+            std::cerr << "test_module(): Can't load the file as BGR image: " << TestImageList[i] << std::endl;
+            for (int j = 0; j < i; j++)
+            {
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            return 1;
+        }
+        int ret = bgrToNv12(api, bgr_image, &images[i]);
+        api.erImageFree(&bgr_image);
+        if (ret != 0)
+        {
+            for (int j = 0; j < i; j++)
+            {
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            return 1;
+        }
+    }
+
+    // Convert-then-detect, the NV12 frame is converted to a full-resolution BGR image first
+    long long duration_convert = 0;
+    unsigned int num_convert_evals = 0;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            ERImage bgr_image;
+            if (api.erImageAllocate(&bgr_image, images[i].width, images[i].height, ER_IMAGE_COLORMODEL_BGR, ER_IMAGE_DATATYPE_UCHAR) != 0)
+            {
+                continue;
+            }
+            nv12ToBgr(images[i], &bgr_image);
+            SaDetResult det_result;
+            int ret = api.saRunDet(sa_state, bgr_image, nullptr, &det_result);
+            api.erImageFree(&bgr_image);
+            if (ret != 0)
+            {
+                continue;
+            }
+            duration_convert += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+            num_convert_evals += 1;
+            api.saFreeDetResult(sa_state, &det_result);
+        }
+    }
+
+    // Native NV12 detection, converted together with resizing into the network input
+    long long duration_native = 0;
+    unsigned int num_native_evals = 0;
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+            /** [DetNV12] */
+            // Run detection directly on the NV12 image
+            SaDetResult det_result;
+            if (api.saRunDet(sa_state, images[i], nullptr, &det_result) != 0)
+            {
+                continue;
+            }
+            /** [DetNV12] */
+            duration_native += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+            num_native_evals += 1;
+
+            if (r == NUM_ROUNDS - 1)
+            {
+                printf("Image %s - found %d detections\n", TestImageList[i], det_result.num_detections);
+                for (int j = 0; j < det_result.num_detections; j++)
+                {
+                    SaDetection& det = det_result.detections[j];
+                    // Classify only a windshield detections
+                    if (std::strncmp((char *)det.label, "window", sizeof("window") - 1) != 0)
+                    {
+                        continue;
+                    }
+                    // Run Seat Classification on the NV12 image as well
+                    SaSclResult scl_result;
+                    if (api.saRunScl(sa_state, images[i], &det.position, det.label, &scl_result) != 0)
+                    {
+                        continue;
+                    }
+                    printf("  - left: %s middle: %s right: %s\n",
+                        scl_result.left.occupied.result, scl_result.middle.occupied.result, scl_result.right.occupied.result);
+                }
+            }
+            api.saFreeDetResult(sa_state, &det_result);
+        }
+    }
+
+    if (num_convert_evals > 0) {
+        printSpeed("Convert-then-detect speed", num_convert_evals, duration_convert);
+    }
+    if (num_native_evals > 0) {
+        printSpeed("Native NV12 detector speed", num_native_evals, duration_native);
+    }
+    if (num_convert_evals > 0 && num_native_evals > 0 && duration_convert > 0 && duration_native > 0) {
+        printf("NV12 speed-up: %.2fx\n",
+            ((double)num_native_evals / duration_native) / ((double)num_convert_evals / duration_convert));
+    }
+
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        api.erImageFree(&images[i]);
+    }
+
+    // Free the SDK state
+    api.saFree(sa_state);
+    return 0;
+}
@@ -0,0 +1,541 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//       Seats analyzer library model reload example     //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Usage: example_reload [SECOND_CONFIG]
+//   SECOND_CONFIG  config file of a second model set, e.g. an older model release. The reloads switch between
+//                  the two sets and the test checks that every call used the models active at its time. Without
+//                  it the same models are reloaded and only failures and stalls are checked.
+
+// Number of worker threads processing images during the reloads
+#define NUM_WORKERS 4
+// Number of model reloads, even so that the last one switches back to the initial models
+#define NUM_RELOADS 4
+// Duration of the phase without reloads and the pause between reloads
+#define PHASE_MS 2000
+// Number of calls every worker makes after the end of a phase, i.e. with the weights of the last reload
+#define CALLS_AFTER_PHASE 20
+// Allowed ratio of the 99th percentile of call latency during reloads to the one without reloads, a call
+// spanning the end of a reload and exceeding this ratio is considered to have waited for the reload
+#define MAX_P99_FACTOR 3.
+// Maximal difference of detection values produced by the same models
+#define DETECTION_TOLERANCE 1e-3f
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+// Detections of one image flattened to numbers, identifies the models which produced them
+typedef std::vector<float> Signature;
+
+// Expected signatures of all images for both model sets
+typedef std::vector<Signature> ModelSignatures[2];
+
+// A single detection call of a worker
+struct CallRecord
+{
+    Clock::time_point start;
+    Clock::time_point end;
+    int               model_set; // index of the model set which produced the result, -1 for none
+};
+
+// A single reload, model_set is the set active after it
+struct ReloadRecord
+{
+    Clock::time_point start;
+    Clock::time_point end;
+    int               model_set;
+};
+
+// Counters of one worker thread
+struct WorkerStats
+{
+    unsigned int num_failures = 0;
+    std::vector<CallRecord> calls;
+};
+
+// Counters of all workers of a phase
+struct PhaseStats
+{
+    unsigned int num_calls = 0;
+    unsigned int num_failures = 0;
+    double p99_latency_ms = 0.;
+    double max_latency_ms = 0.;
+    std::vector<CallRecord> calls;
+    std::vector<ReloadRecord> reloads;
+};
+
+static double durationMs(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.;
+}
+
+static Signature getSignature(const SaDetResult &det_result)
+{
+    Signature signature(1, (float)det_result.num_detections);
+    for (int j = 0; j < det_result.num_detections; j++)
+    {
+        const SaDetection &det = det_result.detections[j];
+        signature.push_back(det.confidence);
+        signature.push_back(det.position.x);
+        signature.push_back(det.position.y);
+        signature.push_back(det.position.width);
+        signature.push_back(det.position.height);
+    }
+    return signature;
+}
+
+static bool isSameSignature(const Signature &a, const Signature &b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t k = 0; k < a.size(); k++)
+    {
+        if (std::fabs(a[k] - b[k]) > DETECTION_TOLERANCE)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns the index of the model set which produced the detections of the image, -1 if none did
+static int identifyModelSet(const ModelSignatures &signatures, size_t image_index, const SaDetResult &det_result)
+{
+    Signature signature = getSignature(det_result);
+    for (int m = 0; m < 2; m++)
+    {
+        if (isSameSignature(signature, signatures[m][image_index]))
+        {
+            return m;
+        }
+    }
+    return -1;
+}
+
+// Computes the signatures of all images with the given state
+static bool computeSignatures(const SaAPI &api, SAState sa_state, const std::vector<ERImage> &images,
+                              std::vector<Signature> *signatures)
+{
+    signatures->clear();
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        SaDetResult det_result;
+        if (api.saRunDet(sa_state, images[i], nullptr, &det_result) != 0)
+        {
+            return false;
+        }
+        signatures->push_back(getSignature(det_result));
+        api.saFreeDetResult(sa_state, &det_result);
+    }
+    return true;
+}
+
+// Runs detection on the images until stopped and CALLS_AFTER_PHASE more calls after that,
+// every call is expected to succeed
+static void processImages(const SaAPI *api, SAState sa_state, const std::vector<ERImage> *images,
+                          const ModelSignatures *signatures, const std::atomic<bool> *stop, WorkerStats *stats)
+{
+    int calls_after_stop = 0;
+    for (size_t i = 0; calls_after_stop < CALLS_AFTER_PHASE; i = (i + 1) % images->size())
+    {
+        if (*stop)
+        {
+            calls_after_stop++;
+        }
+        CallRecord call;
+        call.start = Clock::now();
+        SaDetResult det_result;
+        if (api->saRunDet(sa_state, (*images)[i], nullptr, &det_result) != 0)
+        {
+            stats->num_failures += 1;
+            continue;
+        }
+        call.end = Clock::now();
+        call.model_set = identifyModelSet(*signatures, i, det_result);
+        api->saFreeDetResult(sa_state, &det_result);
+        stats->calls.push_back(call);
+    }
+}
+
+// Runs every state once on all images, so that no cold first call is measured
+static void warmUp(const SaAPI &api, const std::vector<SAState> &states, const std::vector<ERImage> &images)
+{
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < states.size(); t++)
+    {
+        threads.push_back(std::thread([&api, &images](SAState sa_state) {
+            for (size_t i = 0; i < images.size(); i++)
+            {
+                SaDetResult det_result;
+                if (api.saRunDet(sa_state, images[i], nullptr, &det_result) == 0)
+                {
+                    api.saFreeDetResult(sa_state, &det_result);
+                }
+            }
+        }, states[t]));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+}
+
+// Runs the workers for the given time. If requested, reloads the models NUM_RELOADS times in between, switching
+// between the two config files, and checks by the verifier clone that the calls after each reload use the new models.
+static void runPhase(const SaAPI &api, SAState sa_state, SAState verifier, const std::vector<SAState> &states,
+                     const std::vector<ERImage> &images, const char *const config_filenames[2],
+                     const ModelSignatures &signatures, bool reload, PhaseStats *stats,
+                     unsigned int *num_reload_failures, unsigned int *num_verify_failures)
+{
+    std::atomic<bool> stop(false);
+    std::vector<WorkerStats> worker_stats(states.size());
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < states.size(); t++)
+    {
+        threads.push_back(std::thread(processImages, &api, states[t], &images, &signatures, &stop, &worker_stats[t]));
+    }
+    int model_set = 0;
+    for (int r = 0; r < (reload ? NUM_RELOADS : 1); r++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(PHASE_MS / (reload ? NUM_RELOADS : 1)));
+        if (!reload)
+        {
+            continue;
+        }
+        ReloadRecord record;
+        record.start = Clock::now();
+        /** [Reload] */
+        // Load the other model set and swap it in while the workers keep running. The models are loaded by this
+        // thread, the workers are not blocked by the loading.
+        if (api.saReloadModels(sa_state, config_filenames[1 - model_set], nullptr) != 0)
+        {
+            *num_reload_failures += 1;
+        }
+        else
+        {
+            model_set = 1 - model_set;
+        }
+        /** [Reload] */
+        record.end = Clock::now();
+        record.model_set = model_set;
+        stats->reloads.push_back(record);
+        printf("Reload %d to %s took %.1f ms\n", r + 1, config_filenames[model_set], durationMs(record.start, record.end));
+
+        // Every call started after the swap has to use the new models
+        for (size_t i = 0; i < images.size(); i++)
+        {
+            SaDetResult det_result;
+            if (api.saRunDet(verifier, images[i], nullptr, &det_result) != 0)
+            {
+                *num_verify_failures += 1;
+                continue;
+            }
+            if (identifyModelSet(signatures, i, det_result) != model_set)
+            {
+                *num_verify_failures += 1;
+            }
+            api.saFreeDetResult(verifier, &det_result);
+        }
+    }
+    // The workers keep running for CALLS_AFTER_PHASE calls, exercising the weights of the last reload
+    stop = true;
+    std::vector<double> latencies_ms;
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+        stats->num_failures += worker_stats[t].num_failures;
+        stats->calls.insert(stats->calls.end(), worker_stats[t].calls.begin(), worker_stats[t].calls.end());
+    }
+    for (size_t k = 0; k < stats->calls.size(); k++)
+    {
+        latencies_ms.push_back(durationMs(stats->calls[k].start, stats->calls[k].end));
+    }
+    stats->num_calls = (unsigned int)latencies_ms.size() + stats->num_failures;
+    if (!latencies_ms.empty())
+    {
+        std::sort(latencies_ms.begin(), latencies_ms.end());
+        stats->p99_latency_ms = latencies_ms[(latencies_ms.size() - 1) * 99 / 100];
+        stats->max_latency_ms = latencies_ms.back();
+    }
+}
+
+// Counts calls which waited for a reload, i.e. spanned the end of the reload and took more than the allowed latency
+static unsigned int countStalledCalls(const PhaseStats &stats, double max_latency_ms)
+{
+    unsigned int num_stalled = 0;
+    for (size_t k = 0; k < stats.calls.size(); k++)
+    {
+        const CallRecord &call = stats.calls[k];
+        for (size_t r = 0; r < stats.reloads.size(); r++)
+        {
+            const ReloadRecord &reload = stats.reloads[r];
+            if (call.start < reload.end && call.end > reload.end && durationMs(call.start, call.end) > max_latency_ms)
+            {
+                num_stalled++;
+                break;
+            }
+        }
+    }
+    return num_stalled;
+}
+
+// Counts calls which did not use the models active at their time. A call overlapping a reload may use either
+// the models before or after it, any other call the models of the last reload finished before it started.
+static unsigned int countWrongModelCalls(const PhaseStats &stats)
+{
+    unsigned int num_wrong = 0;
+    for (size_t k = 0; k < stats.calls.size(); k++)
+    {
+        const CallRecord &call = stats.calls[k];
+        int model_set = 0;
+        int overlapped_model_set = -1;
+        for (size_t r = 0; r < stats.reloads.size(); r++)
+        {
+            const ReloadRecord &reload = stats.reloads[r];
+            if (reload.end <= call.start)
+            {
+                model_set = reload.model_set;
+            }
+            else if (reload.start < call.end)
+            {
+                overlapped_model_set = reload.model_set;
+            }
+        }
+        if (call.model_set != model_set && call.model_set != overlapped_model_set)
+        {
+            num_wrong++;
+        }
+    }
+    return num_wrong;
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 1;
+
+    // The reloads switch between the two config files
+    const char *const config_filenames[2] = { CONFIG_FILENAME, argc > 1 ? argv[1] : CONFIG_FILENAME };
+
+    SAState sa_state;
+    if (api.saInit(config_filenames[0], &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    // Read all input images, the images are shared read-only by all threads
+    std::vector<ERImage> images(NUM_IMG);
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        if (api.erImageRead(&images[i], TestImageList[i]) != 0)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            for (int j = 0; j < i; j++)
+            {
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            return 1;
+        }
+    }
+
+    // Detections of both model sets, the second set by a separate state
+    ModelSignatures signatures;
+    bool signatures_ok = computeSignatures(api, sa_state, images, &signatures[0]);
+    SAState sa_state_second;
+    if (signatures_ok && api.saInit(config_filenames[1], &config, &sa_state_second) == 0)
+    {
+        signatures_ok = computeSignatures(api, sa_state_second, images, &signatures[1]);
+        api.saFree(sa_state_second);
+    }
+    else
+    {
+        signatures_ok = false;
+    }
+    bool distinct_models = false;
+    for (int i = 0; signatures_ok && i < NUM_IMG; i++)
+    {
+        distinct_models = distinct_models || !isSameSignature(signatures[0][i], signatures[1][i]);
+    }
+    if (!distinct_models)
+    {
+        printf("The model sets give the same detections, the switch of the weights is not checked\n");
+    }
+
+    // Clone the state for the workers and for the verification after each reload,
+    // the first worker uses the initialized state
+    std::vector<SAState> states(1, sa_state);
+    SAState verifier = nullptr;
+    for (int t = 0; t < NUM_WORKERS && signatures_ok; t++)
+    {
+        SAState sa_state_clone;
+        if (api.saCloneState(sa_state, &sa_state_clone) != 0)
+        {
+            break;
+        }
+        if (t == 0)
+        {
+            verifier = sa_state_clone;
+        }
+        else
+        {
+            states.push_back(sa_state_clone);
+        }
+    }
+
+    int ret = 0;
+    if (verifier != nullptr)
+    {
+        // Baseline without reloads, then the same load with reloads
+        PhaseStats baseline;
+        PhaseStats reloading;
+        unsigned int num_reload_failures = 0;
+        unsigned int num_verify_failures = 0;
+        warmUp(api, states, images);
+        runPhase(api, sa_state, verifier, states, images, config_filenames, signatures, false, &baseline,
+                 &num_reload_failures, &num_verify_failures);
+        runPhase(api, sa_state, verifier, states, images, config_filenames, signatures, true, &reloading,
+                 &num_reload_failures, &num_verify_failures);
+
+        printf("Without reloads: %u calls, %u failed, p99 latency %.1f ms, max latency %.1f ms\n",
+            baseline.num_calls, baseline.num_failures, baseline.p99_latency_ms, baseline.max_latency_ms);
+        printf("With reloads:    %u calls, %u failed, p99 latency %.1f ms, max latency %.1f ms\n",
+            reloading.num_calls, reloading.num_failures, reloading.p99_latency_ms, reloading.max_latency_ms);
+
+        if (num_reload_failures > 0)
+        {
+            printf("FAILED: %u of %d reloads failed\n", num_reload_failures, NUM_RELOADS);
+            ret = 1;
+        }
+        if (reloading.num_failures > 0 || reloading.num_calls == 0)
+        {
+            printf("FAILED: calls failed during the reloads\n");
+            ret = 1;
+        }
+        if (reloading.p99_latency_ms > MAX_P99_FACTOR * baseline.p99_latency_ms)
+        {
+            printf("FAILED: calls slowed down during the reloads, allowed p99 latency %.1f ms\n", MAX_P99_FACTOR * baseline.p99_latency_ms);
+            ret = 1;
+        }
+        unsigned int num_stalled = countStalledCalls(reloading, MAX_P99_FACTOR * baseline.p99_latency_ms);
+        if (num_stalled > 0)
+        {
+            printf("FAILED: %u calls waited for a reload\n", num_stalled);
+            ret = 1;
+        }
+        unsigned int num_wrong = distinct_models ? countWrongModelCalls(reloading) : 0;
+        if (num_wrong > 0 || (distinct_models && num_verify_failures > 0))
+        {
+            printf("FAILED: %u worker calls and %u calls after a swap did not use the active models\n",
+                num_wrong, num_verify_failures);
+            ret = 1;
+        }
+        if (ret == 0)
+        {
+            printf("PASSED\n");
+        }
+    }
+    else
+    {
+        printf("FAILED: initialization of the test failed\n");
+        ret = 1;
+    }
+
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        api.erImageFree(&images[i]);
+    }
+
+    // Free the clones and the SDK state
+    if (verifier != nullptr)
+    {
+        api.saFree(verifier);
+    }
+    for (size_t t = states.size(); t-- > 0;)
+    {
+        api.saFree(states[t]);
+    }
+    return ret;
+}
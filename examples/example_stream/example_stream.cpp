@@ -0,0 +1,217 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//         Seats analyzer library stream example         //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Every image is fed to the stream several times to simulate consecutive video frames
+#define FRAMES_PER_IMAGE 12
+// Number of frames of the simulated lighting drift and the brightness step between them
+#define DRIFT_FRAMES 200
+#define DRIFT_STEP 0.25f
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+static void printGateStats(const SaAPI &api, SAStream sa_stream, const char *name)
+{
+    SaStreamStats stats;
+    if (api.saStreamGetStats(sa_stream, &stats) == 0 && stats.frames > 0)
+    {
+        printf("%s scene change gate: %llu frames skipped, %llu frames processed\n",
+            name, stats.gated_frames, stats.frames - stats.gated_frames);
+    }
+}
+
+static void printTracks(const SaStreamResult &result)
+{
+    for (int t = 0; t < result.num_tracks; t++)
+    {
+        const SaTrack& track = result.tracks[t];
+        if (!track.finished)
+        {
+            continue;
+        }
+        printf("Track %d finished after %d frames, label %s, classified from frame %llu\n",
+            track.track_id, track.num_frames, track.detection.label, track.best_frame);
+        if (track.has_scl)
+        {
+            printf("  - left: %s middle: %s right: %s\n",
+                track.scl_result.left.occupied.result, track.scl_result.middle.occupied.result, track.scl_result.right.occupied.result);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 1;
+
+    SAState sa_state;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    /** [StreamCreate] */
+    // Create the stream, full-frame detection is run every 8th frame
+    SaStreamConfig stream_config;
+    std::memset(&stream_config, 0, sizeof(SaStreamConfig));
+    stream_config.redetect_interval = 8;
+    // Skip detection on frames without a scene change
+    stream_config.change_gate = 1;
+    stream_config.change_gate_threshold = 4.f;
+    stream_config.change_gate_downscale = 8;
+    stream_config.change_gate_learning_rate = 0.05f;
+    stream_config.change_gate_refresh_interval = 25;
+    SAStream sa_stream;
+    if (api.saStreamCreate(sa_state, &stream_config, &sa_stream) != 0)
+    {
+        api.saFree(sa_state);
+        return 1;
+    }
+    /** [StreamCreate] */
+
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        ERImage er_image;
+        if (api.erImageRead(&er_image, TestImageList[i]) != 0)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            continue;
+        }
+
+        for (int f = 0; f < FRAMES_PER_IMAGE; f++)
+        {
+            /** [StreamProcess] */
+            // Process the next frame, finished tracks carry their classification
+            SaStreamResult stream_result;
+            if (api.saStreamProcess(sa_stream, er_image, &stream_result) != 0)
+            {
+                continue;
+            }
+            printTracks(stream_result);
+            api.saFreeStreamResult(sa_stream, &stream_result);
+            /** [StreamProcess] */
+        }
+
+        api.erImageFree(&er_image);
+    }
+
+    /** [StreamFlush] */
+    // Finish the tracks still active at the end of the stream
+    SaStreamResult stream_result;
+    if (api.saStreamFlush(sa_stream, &stream_result) == 0)
+    {
+        printTracks(stream_result);
+        api.saFreeStreamResult(sa_stream, &stream_result);
+    }
+    /** [StreamFlush] */
+
+    SaStreamStats stats;
+    if (api.saStreamGetStats(sa_stream, &stats) == 0 && stats.frames > 0)
+    {
+        printf("Stream: %llu frames, %llu full-frame detections, %llu RoI detections, %llu tracks, %llu classifications\n",
+            stats.frames, stats.full_detections, stats.roi_detections, stats.tracks, stats.scl_runs);
+        printf("Full-frame detection on %.1f %% of frames\n", 100. * stats.full_detections / (double)stats.frames);
+    }
+    printGateStats(api, sa_stream, "Stream");
+    api.saStreamFree(sa_stream);
+
+    // Simulate a slow lighting drift of an empty scene. The background follows the drift, so the gate skips most of
+    // the frames instead of staying open once the difference to the first frame exceeds the threshold.
+    ERImage drift_image;
+    if (api.erImageAllocate(&drift_image, 640, 480, ER_IMAGE_COLORMODEL_BGR, ER_IMAGE_DATATYPE_UCHAR) == 0)
+    {
+        if (api.saStreamCreate(sa_state, &stream_config, &sa_stream) == 0)
+        {
+            for (int f = 0; f < DRIFT_FRAMES; f++)
+            {
+                std::memset(drift_image.data, 64 + (int)(f * DRIFT_STEP), drift_image.size);
+                SaStreamResult drift_result;
+                if (api.saStreamProcess(sa_stream, drift_image, &drift_result) == 0)
+                {
+                    api.saFreeStreamResult(sa_stream, &drift_result);
+                }
+            }
+            printGateStats(api, sa_stream, "Drift");
+            api.saStreamFree(sa_stream);
+        }
+        api.erImageFree(&drift_image);
+    }
+
+    // Free the SDK state
+    api.saFree(sa_state);
+    return 0;
+}
@@ -0,0 +1,239 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//      Seats analyzer library multi-threaded example    //
+///////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+// Number of times the whole image list is processed by each thread
+#define NUM_ROUNDS 10
+
+const char TestImageList[][4096] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+};
+int NUM_IMG = sizeof(TestImageList)/4096;
+
+// Processes the whole image list NUM_ROUNDS times, saRunDet and saRunScl on each window detection
+static void processImages(const SaAPI *api, SAState sa_state, const std::vector<ERImage> *images, unsigned int *num_frames)
+{
+    for (int r = 0; r < NUM_ROUNDS; r++)
+    {
+        for (size_t i = 0; i < images->size(); i++)
+        {
+            SaDetResult det_result;
+            if (api->saRunDet(sa_state, (*images)[i], nullptr, &det_result) != 0)
+            {
+                continue;
+            }
+            for (int j = 0; j < det_result.num_detections; j++)
+            {
+                SaDetection& det = det_result.detections[j];
+                // Classify only a windshield detections
+                if (std::strncmp((char *)det.label, "window", sizeof("window") - 1) != 0)
+                {
+                    continue;
+                }
+                SaSclResult scl_result;
+                api->saRunScl(sa_state, (*images)[i], &det.position, det.label, &scl_result);
+            }
+            api->saFreeDetResult(sa_state, &det_result);
+            *num_frames += 1;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+#ifdef SA_USE_GPU
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_GPU;
+#else
+    config.computation_mode = ERComputationMode::ER_COMPUTATION_MODE_CPU;
+#endif
+    config.gpu_device_id = 0;
+    config.num_threads = 1;
+
+    SAState sa_state;
+    if (api.saInit(CONFIG_FILENAME, &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    // Read all input images, the images are shared read-only by all threads
+    std::vector<ERImage> images(NUM_IMG);
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        if (api.erImageRead(&images[i], TestImageList[i]) != 0)
+        {
+            std::cerr << "test_module(): Can't load the file: " << TestImageList[i] << std::endl;
+            for (int j = 0; j < i; j++)
+            {
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            return 1;
+        }
+    }
+
+    unsigned int max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0)
+    {
+        max_threads = 1;
+    }
+
+    // Clone the state for every worker thread, the models are loaded only once
+    std::vector<SAState> states(1, sa_state);
+    for (unsigned int t = 1; t < max_threads; t++)
+    {
+        std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+        /** [Clone] */
+        // Create a state sharing the models of the initialized one
+        SAState sa_state_clone;
+        if (api.saCloneState(sa_state, &sa_state_clone) != 0)
+        {
+            break;
+        }
+        /** [Clone] */
+        if (t == 1)
+        {
+            printf("State cloned in %f ms\n",
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count() / 1000.);
+        }
+        states.push_back(sa_state_clone);
+    }
+    max_threads = (unsigned int)states.size();
+
+    // Optionally trace all threads, the trace file is given as the first argument
+    const char *trace_filename = argc > 1 ? argv[1] : nullptr;
+    if (trace_filename != nullptr)
+    {
+        /** [TraceStart] */
+        api.saTraceStart(sa_state, 0);
+        /** [TraceStart] */
+    }
+
+    // Measure the throughput for 1, 2, 4, ... threads up to the number of cores
+    double single_thread_fps = 0.;
+    for (unsigned int num_threads = 1; ; num_threads = std::min(num_threads * 2, max_threads))
+    {
+        std::vector<unsigned int> num_frames(num_threads, 0);
+        std::vector<std::thread> threads;
+        std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+        for (unsigned int t = 0; t < num_threads; t++)
+        {
+            threads.push_back(std::thread(processImages, &api, states[t], &images, &num_frames[t]));
+        }
+        for (unsigned int t = 0; t < num_threads; t++)
+        {
+            threads[t].join();
+        }
+        long long duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t1).count();
+
+        unsigned int total_frames = 0;
+        for (unsigned int t = 0; t < num_threads; t++)
+        {
+            total_frames += num_frames[t];
+        }
+        double fps = duration > 0 ? (double)total_frames / duration * 1000000. : 0.;
+        if (num_threads == 1)
+        {
+            single_thread_fps = fps;
+        }
+        printf("%u threads: %u frames, %.1f ms, %f Hz, scaling efficiency %.1f %%\n",
+            num_threads, total_frames, duration / 1000., fps,
+            single_thread_fps > 0. ? 100. * fps / (single_thread_fps * num_threads) : 0.);
+
+        if (num_threads == max_threads)
+        {
+            break;
+        }
+    }
+
+    if (trace_filename != nullptr)
+    {
+        /** [TraceStop] */
+        // Write the spans recorded by all threads
+        if (api.saTraceStop(sa_state, trace_filename) == 0)
+        {
+            printf("Trace written to %s\n", trace_filename);
+        }
+        /** [TraceStop] */
+    }
+
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        api.erImageFree(&images[i]);
+    }
+
+    // Free the clones and the SDK state
+    for (size_t t = 0; t < states.size(); t++)
+    {
+        api.saFree(states[t]);
+    }
+    return 0;
+}
@@ -0,0 +1,832 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2016-2021 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                         SA SDK                        //
+//           Seats analyzer library regression           //
+///////////////////////////////////////////////////////////
+
+// Usage: regression (--record FILE | --compare FILE) [options]
+//   --record FILE              run all images and store the results as golden output
+//   --compare FILE             run all images and compare the results with the golden output
+//   --images DIR               process all .jpg/.jpeg/.png images from DIR (default ../../data/images/)
+//   --mode cpu|gpu|tpu         computation mode (default cpu)
+//   --threads N                number of worker threads, each with its own SAState (default 1)
+//   --sdk-threads N            SaConfig::num_threads of every state (default 1)
+//   --precision fp32|int8      inference precision (default fp32)
+//   --cpu-dispatch NAME        image kernels auto|scalar|sse4|avx2 (default auto), e.g. record with scalar
+//                              and compare with the SIMD kernels
+//   --config FILE              SDK config file (default ../../sdk/config.ini)
+//   --min-iou F                minimal IoU of a detection and its golden counterpart (default 0.95)
+//   --confidence-tolerance F   maximal difference of confidences and qualities (default 0.02)
+//
+// Detections are matched to the golden ones by label and IoU of the rotated rectangles.
+// When comparing, saRunScl runs on the golden windshield positions, so the classification is
+// checked independently of the detector. Classification results ('0', '1', '?') must match exactly.
+// Returns zero when all results match the golden output.
+
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <dirent.h>
+#endif
+
+#include <SeatsAnalyzer.h>
+#include <er_explink.h>
+#include <er_type.h>
+
+// Path to module(s) directory
+#define LIB_FILENAME ER_LIB_PREFIX "seatsanalyzer" SA_SUFFIX "-" ER_LIB_TARGET DEBUG_SUFFIX ER_LIB_EXT
+#define SDK_DIR     "../../sdk/"
+#define SA_LIBRARY SDK_DIR "lib/" LIB_FILENAME
+#define CONFIG_FILENAME  SDK_DIR "config.ini"
+#define IMAGES_DIR          "../../data/images/"
+
+#define GOLDEN_HEADER "# SA golden output v2"
+
+static const char *CPU_DISPATCH_NAMES[] = {"auto", "scalar", "sse4", "avx2"};
+
+struct RegressionOptions
+{
+    std::string golden_filename;
+    bool record = false;
+    std::string images_dir = IMAGES_DIR;
+    std::string config_filename = CONFIG_FILENAME;
+    ERComputationMode computation_mode = ER_COMPUTATION_MODE_CPU;
+    int threads = 1;
+    int sdk_threads = 1;
+    SaPrecision precision = SA_PRECISION_FP32;
+    SaCpuDispatch cpu_dispatch = SA_CPU_DISPATCH_AUTO;
+    double min_iou = 0.95;
+    double confidence_tolerance = 0.02;
+};
+
+// A detection with the classification of its windshield
+struct ResultDetection
+{
+    SaDetection detection;
+    bool        has_scl;
+    SaSclResult scl_result;
+};
+
+// Results of a single image, golden or current
+struct ImageResult
+{
+    std::string                  name;
+    std::vector<ResultDetection> detections;
+    bool                         ok = true;
+};
+
+static const char *POSITION_NAMES[] = {"left", "middle", "right"};
+static const char *TASK_NAMES[] = {"occupied", "driver", "belt", "phone"};
+
+static const SaPosition& getPosition(const SaSclResult& result, int p)
+{
+    return p == 0 ? result.left : (p == 1 ? result.middle : result.right);
+}
+
+static SaPosition& getPosition(SaSclResult& result, int p)
+{
+    return p == 0 ? result.left : (p == 1 ? result.middle : result.right);
+}
+
+static const SaClass& getTask(const SaPosition& position, int t)
+{
+    const SaClass *tasks[] = {&position.occupied, &position.driver, &position.belt, &position.phone};
+    return *tasks[t];
+}
+
+static SaClass& getTask(SaPosition& position, int t)
+{
+    SaClass *tasks[] = {&position.occupied, &position.driver, &position.belt, &position.phone};
+    return *tasks[t];
+}
+
+static bool isWindow(const char *label)
+{
+    return std::strncmp(label, "window", sizeof("window") - 1) == 0;
+}
+
+static bool parseOptions(int argc, char *argv[], RegressionOptions *options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if ((arg == "--record" || arg == "--compare") && has_value)
+        {
+            options->record = arg == "--record";
+            options->golden_filename = argv[++i];
+        }
+        else if (arg == "--images" && has_value)
+        {
+            options->images_dir = argv[++i];
+        }
+        else if (arg == "--mode" && has_value)
+        {
+            std::string mode = argv[++i];
+            if (mode == "cpu")
+            {
+                options->computation_mode = ER_COMPUTATION_MODE_CPU;
+            }
+            else if (mode == "gpu")
+            {
+                options->computation_mode = ER_COMPUTATION_MODE_GPU;
+            }
+            else if (mode == "tpu")
+            {
+                options->computation_mode = ER_COMPUTATION_MODE_TPU;
+            }
+            else
+            {
+                std::cerr << "Unknown computation mode: " << mode << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--threads" && has_value)
+        {
+            options->threads = std::atoi(argv[++i]);
+        }
+        else if (arg == "--sdk-threads" && has_value)
+        {
+            options->sdk_threads = std::atoi(argv[++i]);
+        }
+        else if (arg == "--cpu-dispatch" && has_value)
+        {
+            std::string name = argv[++i];
+            int d = 0;
+            while (d < 4 && name != CPU_DISPATCH_NAMES[d])
+            {
+                d++;
+            }
+            if (d == 4)
+            {
+                std::cerr << "Unknown CPU dispatch: " << name << std::endl;
+                return false;
+            }
+            options->cpu_dispatch = (SaCpuDispatch)d;
+        }
+        else if (arg == "--precision" && has_value)
+        {
+            std::string name = argv[++i];
+            if (name != "fp32" && name != "int8")
+            {
+                std::cerr << "Unknown precision: " << name << std::endl;
+                return false;
+            }
+            options->precision = name == "int8" ? SA_PRECISION_INT8 : SA_PRECISION_FP32;
+        }
+        else if (arg == "--config" && has_value)
+        {
+            options->config_filename = argv[++i];
+        }
+        else if (arg == "--min-iou" && has_value)
+        {
+            options->min_iou = std::atof(argv[++i]);
+        }
+        else if (arg == "--confidence-tolerance" && has_value)
+        {
+            options->confidence_tolerance = std::atof(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            return false;
+        }
+    }
+    if (options->golden_filename.empty())
+    {
+        std::cerr << "One of --record FILE or --compare FILE is required" << std::endl;
+        return false;
+    }
+    if (options->threads < 1 || options->sdk_threads < 1)
+    {
+        std::cerr << "Invalid option value" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool hasImageExtension(const std::string& filename)
+{
+    size_t dot = filename.find_last_of('.');
+    if (dot == std::string::npos)
+    {
+        return false;
+    }
+    std::string ext = filename.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == "jpg" || ext == "jpeg" || ext == "png";
+}
+
+// Lists image files of a directory in alphabetical order, without the directory prefix
+static std::vector<std::string> listImages(const std::string& dir)
+{
+    std::vector<std::string> filenames;
+#ifdef _WIN32
+    WIN32_FIND_DATAA find_data;
+    HANDLE hfind = FindFirstFileA((dir + "/*").c_str(), &find_data);
+    if (hfind != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if (hasImageExtension(find_data.cFileName))
+            {
+                filenames.push_back(find_data.cFileName);
+            }
+        } while (FindNextFileA(hfind, &find_data));
+        FindClose(hfind);
+    }
+#else
+    DIR *dirp = opendir(dir.c_str());
+    if (dirp != nullptr)
+    {
+        for (struct dirent *entry = readdir(dirp); entry != nullptr; entry = readdir(dirp))
+        {
+            if (hasImageExtension(entry->d_name))
+            {
+                filenames.push_back(entry->d_name);
+            }
+        }
+        closedir(dirp);
+    }
+#endif
+    std::sort(filenames.begin(), filenames.end());
+    return filenames;
+}
+
+///////////////////////////////////////////////////////////
+//               Rotated rectangle overlap               //
+///////////////////////////////////////////////////////////
+
+struct Point
+{
+    double x;
+    double y;
+};
+
+static std::vector<Point> rectCorners(const ERRotatedRect& rect)
+{
+    const double pi = 3.14159265358979323846;
+    double a = rect.angle * pi / 180.;
+    double c = std::cos(a), s = std::sin(a);
+    double hw = rect.width / 2., hh = rect.height / 2.;
+    const double dx[] = {-hw, hw, hw, -hw};
+    const double dy[] = {-hh, -hh, hh, hh};
+    std::vector<Point> corners(4);
+    for (int i = 0; i < 4; i++)
+    {
+        corners[i].x = rect.x + dx[i] * c - dy[i] * s;
+        corners[i].y = rect.y + dx[i] * s + dy[i] * c;
+    }
+    return corners;
+}
+
+static double polygonArea(const std::vector<Point>& polygon)
+{
+    double area = 0.;
+    for (size_t i = 0; i < polygon.size(); i++)
+    {
+        const Point& p = polygon[i];
+        const Point& q = polygon[(i + 1) % polygon.size()];
+        area += p.x * q.y - q.x * p.y;
+    }
+    return std::fabs(area) / 2.;
+}
+
+// Clips a convex polygon by a convex clip polygon (Sutherland-Hodgman), both in the same orientation
+static std::vector<Point> clipPolygon(std::vector<Point> polygon, const std::vector<Point>& clip)
+{
+    double orientation = 0.;
+    for (size_t i = 0; i < clip.size(); i++)
+    {
+        const Point& p = clip[i];
+        const Point& q = clip[(i + 1) % clip.size()];
+        orientation += p.x * q.y - q.x * p.y;
+    }
+    for (size_t i = 0; i < clip.size() && !polygon.empty(); i++)
+    {
+        const Point& a = clip[i];
+        const Point& b = clip[(i + 1) % clip.size()];
+        std::vector<Point> input;
+        input.swap(polygon);
+        for (size_t j = 0; j < input.size(); j++)
+        {
+            const Point& p = input[j];
+            const Point& q = input[(j + 1) % input.size()];
+            double sp = ((b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x)) * orientation;
+            double sq = ((b.x - a.x) * (q.y - a.y) - (b.y - a.y) * (q.x - a.x)) * orientation;
+            if (sp >= 0.)
+            {
+                polygon.push_back(p);
+            }
+            if ((sp >= 0.) != (sq >= 0.))
+            {
+                double t = sp / (sp - sq);
+                Point r = {p.x + t * (q.x - p.x), p.y + t * (q.y - p.y)};
+                polygon.push_back(r);
+            }
+        }
+    }
+    return polygon;
+}
+
+static double rotatedRectIoU(const ERRotatedRect& r1, const ERRotatedRect& r2)
+{
+    std::vector<Point> p1 = rectCorners(r1);
+    std::vector<Point> p2 = rectCorners(r2);
+    double area1 = polygonArea(p1);
+    double area2 = polygonArea(p2);
+    double intersection = polygonArea(clipPolygon(p1, p2));
+    double union_area = area1 + area2 - intersection;
+    return union_area > 0. ? intersection / union_area : 0.;
+}
+
+///////////////////////////////////////////////////////////
+//                   Golden output file                  //
+///////////////////////////////////////////////////////////
+
+// Format:
+//   image\t<name>\t<num_detections>                            (tab separated, the name may contain spaces)
+//   det <label> <confidence> <x> <y> <width> <height> <angle> <has_scl>
+//   scl <position> <quality> <task> <result> <confidence> ...   (three lines following det if has_scl)
+// An empty classification result (task not implemented) is stored as '-'.
+static bool writeGolden(const std::string& filename, const std::vector<ImageResult>& results)
+{
+    FILE *out = fopen(filename.c_str(), "w");
+    if (out == nullptr)
+    {
+        return false;
+    }
+    fprintf(out, "%s\n", GOLDEN_HEADER);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        fprintf(out, "image\t%s\t%zu\n", results[i].name.c_str(), results[i].detections.size());
+        for (size_t j = 0; j < results[i].detections.size(); j++)
+        {
+            const ResultDetection& det = results[i].detections[j];
+            const ERRotatedRect& r = det.detection.position;
+            fprintf(out, "det %s %.6f %.3f %.3f %.3f %.3f %.3f %d\n", det.detection.label,
+                det.detection.confidence, r.x, r.y, r.width, r.height, r.angle, det.has_scl ? 1 : 0);
+            for (int p = 0; p < 3 && det.has_scl; p++)
+            {
+                const SaPosition& position = getPosition(det.scl_result, p);
+                fprintf(out, "scl %s %.6f", POSITION_NAMES[p], position.quality);
+                for (int t = 0; t < 4; t++)
+                {
+                    const SaClass& task = getTask(position, t);
+                    fprintf(out, " %s %s %.6f", TASK_NAMES[t], task.result[0] != '\0' ? task.result : "-", task.confidence);
+                }
+                fprintf(out, "\n");
+            }
+        }
+    }
+    fclose(out);
+    return true;
+}
+
+// Checks that the last image has all the detections announced by its image line and all the
+// classification lines of its last detection, i.e. that the golden file is not truncated.
+static bool isImageComplete(const std::vector<ImageResult>& results, size_t num_detections, int num_scl_missing)
+{
+    return results.empty() || (results.back().detections.size() == num_detections && num_scl_missing == 0);
+}
+
+static bool readGolden(const std::string& filename, std::vector<ImageResult> *results)
+{
+    std::ifstream in(filename.c_str());
+    std::string line;
+    if (!std::getline(in, line) || line != GOLDEN_HEADER)
+    {
+        return false;
+    }
+    size_t num_detections = 0;
+    int num_scl_missing = 0;
+    while (std::getline(in, line))
+    {
+        std::istringstream ls(line);
+        std::string tag;
+        ls >> tag;
+        if (tag == "image")
+        {
+            if (!isImageComplete(*results, num_detections, num_scl_missing))
+            {
+                return false;
+            }
+            ImageResult image;
+            std::string count;
+            ls.get();
+            if (!std::getline(ls, image.name, '\t') || image.name.empty() || !std::getline(ls, count))
+            {
+                return false;
+            }
+            char *end = nullptr;
+            num_detections = std::strtoul(count.c_str(), &end, 10);
+            if (count.empty() || *end != '\0')
+            {
+                return false;
+            }
+            results->push_back(image);
+        }
+        else if (tag == "det" && !results->empty() && num_scl_missing == 0)
+        {
+            ResultDetection det;
+            std::memset(&det, 0, sizeof(ResultDetection));
+            std::string label;
+            int has_scl = 0;
+            ERRotatedRect& r = det.detection.position;
+            if (!(ls >> label >> det.detection.confidence >> r.x >> r.y >> r.width >> r.height >> r.angle >> has_scl))
+            {
+                return false;
+            }
+            std::strncpy(det.detection.label, label.c_str(), SA_LABEL_STRING_LENGTH - 1);
+            det.has_scl = has_scl != 0;
+            num_scl_missing = det.has_scl ? 3 : 0;
+            results->back().detections.push_back(det);
+            if (results->back().detections.size() > num_detections)
+            {
+                return false;
+            }
+        }
+        else if (tag == "scl" && num_scl_missing > 0)
+        {
+            num_scl_missing--;
+            std::string position_name;
+            double quality = 0.;
+            if (!(ls >> position_name >> quality))
+            {
+                return false;
+            }
+            int p = 0;
+            while (p < 3 && position_name != POSITION_NAMES[p])
+            {
+                p++;
+            }
+            if (p == 3)
+            {
+                return false;
+            }
+            SaPosition& position = getPosition(results->back().detections.back().scl_result, p);
+            position.quality = quality;
+            for (int t = 0; t < 4; t++)
+            {
+                std::string task_name, result;
+                SaClass& task = getTask(position, t);
+                if (!(ls >> task_name >> result >> task.confidence))
+                {
+                    return false;
+                }
+                std::strncpy(task.result, result == "-" ? "" : result.c_str(), SA_LABEL_STRING_LENGTH - 1);
+            }
+        }
+        else if (!tag.empty())
+        {
+            return false;
+        }
+    }
+    return isImageComplete(*results, num_detections, num_scl_missing);
+}
+
+///////////////////////////////////////////////////////////
+//                       Processing                      //
+///////////////////////////////////////////////////////////
+
+// Processes images with indices first, first + step, ... When golden results are given, the
+// classification runs on the golden windshield positions, otherwise on the detected ones.
+static void processImages(const SaAPI *api, SAState sa_state, const std::vector<ERImage> *images,
+                          const std::vector<ImageResult> *golden, size_t first, size_t step,
+                          std::vector<ImageResult> *results, std::vector<std::vector<SaSclResult> > *golden_scl_results)
+{
+    for (size_t i = first; i < images->size(); i += step)
+    {
+        const ERImage& image = (*images)[i];
+        ImageResult& result = (*results)[i];
+
+        SaDetResult det_result;
+        if (api->saRunDet(sa_state, image, nullptr, &det_result) != 0)
+        {
+            result.ok = false;
+            continue;
+        }
+        for (int j = 0; j < det_result.num_detections; j++)
+        {
+            ResultDetection det;
+            std::memset(&det, 0, sizeof(ResultDetection));
+            det.detection = det_result.detections[j];
+            if (golden == nullptr && isWindow(det.detection.label))
+            {
+                det.has_scl = api->saRunScl(sa_state, image, &det.detection.position, det.detection.label, &det.scl_result) == 0;
+                result.ok = result.ok && det.has_scl;
+            }
+            result.detections.push_back(det);
+        }
+        api->saFreeDetResult(sa_state, &det_result);
+
+        if (golden == nullptr)
+        {
+            continue;
+        }
+        const std::vector<ResultDetection>& golden_detections = (*golden)[i].detections;
+        std::vector<SaSclResult>& scl_results = (*golden_scl_results)[i];
+        scl_results.resize(golden_detections.size());
+        for (size_t k = 0; k < golden_detections.size(); k++)
+        {
+            if (!golden_detections[k].has_scl)
+            {
+                continue;
+            }
+            const SaDetection& det = golden_detections[k].detection;
+            if (api->saRunScl(sa_state, image, &det.position, det.label, &scl_results[k]) != 0)
+            {
+                result.ok = false;
+            }
+        }
+    }
+}
+
+static int compareScl(const std::string& where, const SaSclResult& golden, const SaSclResult& current,
+                      double confidence_tolerance)
+{
+    int num_failures = 0;
+    for (int p = 0; p < 3; p++)
+    {
+        const SaPosition& gp = getPosition(golden, p);
+        const SaPosition& cp = getPosition(current, p);
+        if (std::fabs(gp.quality - cp.quality) > confidence_tolerance)
+        {
+            printf("%s %s: quality %.4f, golden %.4f\n", where.c_str(), POSITION_NAMES[p], cp.quality, gp.quality);
+            num_failures++;
+        }
+        for (int t = 0; t < 4; t++)
+        {
+            const SaClass& gt = getTask(gp, t);
+            const SaClass& ct = getTask(cp, t);
+            if (std::strncmp(gt.result, ct.result, SA_LABEL_STRING_LENGTH) != 0)
+            {
+                printf("%s %s %s: result '%s', golden '%s'\n", where.c_str(), POSITION_NAMES[p], TASK_NAMES[t],
+                    ct.result, gt.result);
+                num_failures++;
+            }
+            else if (gt.result[0] != '\0' && std::fabs(gt.confidence - ct.confidence) > confidence_tolerance)
+            {
+                printf("%s %s %s: confidence %.4f, golden %.4f\n", where.c_str(), POSITION_NAMES[p], TASK_NAMES[t],
+                    ct.confidence, gt.confidence);
+                num_failures++;
+            }
+        }
+    }
+    return num_failures;
+}
+
+// Compares the results of a single image, returns the number of differences
+static int compareImage(const ImageResult& golden, const ImageResult& current,
+                        const std::vector<SaSclResult>& golden_scl_results, const RegressionOptions& options)
+{
+    if (!current.ok)
+    {
+        printf("%s: processing failed\n", golden.name.c_str());
+        return 1;
+    }
+    int num_failures = 0;
+    std::vector<bool> used(current.detections.size(), false);
+    for (size_t k = 0; k < golden.detections.size(); k++)
+    {
+        const SaDetection& gd = golden.detections[k].detection;
+        std::ostringstream where;
+        where << golden.name << " det " << k << " (" << gd.label << ")";
+
+        // Best unused detection with the same label
+        int best = -1;
+        double best_iou = 0.;
+        for (size_t j = 0; j < current.detections.size(); j++)
+        {
+            const SaDetection& cd = current.detections[j].detection;
+            if (used[j] || std::strncmp(gd.label, cd.label, SA_LABEL_STRING_LENGTH) != 0)
+            {
+                continue;
+            }
+            double iou = rotatedRectIoU(gd.position, cd.position);
+            if (best < 0 || iou > best_iou)
+            {
+                best = (int)j;
+                best_iou = iou;
+            }
+        }
+        if (best < 0 || best_iou < options.min_iou)
+        {
+            printf("%s: missing, best IoU %.4f\n", where.str().c_str(), best_iou);
+            num_failures++;
+        }
+        else
+        {
+            used[best] = true;
+            const SaDetection& cd = current.detections[best].detection;
+            if (std::fabs(gd.confidence - cd.confidence) > options.confidence_tolerance)
+            {
+                printf("%s: confidence %.4f, golden %.4f\n", where.str().c_str(), cd.confidence, gd.confidence);
+                num_failures++;
+            }
+        }
+        if (golden.detections[k].has_scl)
+        {
+            num_failures += compareScl(where.str(), golden.detections[k].scl_result, golden_scl_results[k],
+                                       options.confidence_tolerance);
+        }
+    }
+    for (size_t j = 0; j < current.detections.size(); j++)
+    {
+        if (!used[j])
+        {
+            printf("%s: extra detection %s (%.4f)\n", golden.name.c_str(), current.detections[j].detection.label,
+                current.detections[j].detection.confidence);
+            num_failures++;
+        }
+    }
+    return num_failures;
+}
+
+int main(int argc, char *argv[])
+{
+    RegressionOptions options;
+    if (!parseOptions(argc, argv, &options))
+    {
+        return 1;
+    }
+
+#ifdef EXPLICIT_LINKING
+    /* load shared library and link functions */
+    SaAPI api;
+    shlib_hnd hdll = nullptr;
+    ER_OPEN_SHLIB(hdll, SA_LIBRARY);
+    if (hdll==nullptr) {
+        std::cout << "Library '" << SA_LIBRARY << "' not loaded!\n" << ER_SHLIB_LASTERROR << "\n";
+        return -1;
+    }
+    fcn_saLinkAPI pfLinkAPI=nullptr;     /* The function which will link all other api functions */
+    ER_LOAD_SHFCN(pfLinkAPI, fcn_saLinkAPI, hdll, "saLinkAPI");
+    if (pfLinkAPI==nullptr) {
+        std::cout << "Loading function 'saLinkAPI' from " << SA_LIBRARY << " failed!\n";
+        return -1;
+    }
+    if ( pfLinkAPI(hdll, &api) != 0 ){
+        std::cout << "Function saLinkAPI() returned with error!\n";
+        return -1;
+    }
+#else
+    SaAPI api;
+    saLinkAPI(nullptr, &api);
+#endif
+
+    // Golden results define the image list when comparing
+    std::vector<ImageResult> golden;
+    std::vector<std::string> names;
+    if (options.record)
+    {
+        names = listImages(options.images_dir);
+    }
+    else
+    {
+        if (!readGolden(options.golden_filename, &golden))
+        {
+            std::cerr << "Can't read the golden output: " << options.golden_filename << std::endl;
+            return 1;
+        }
+        for (size_t i = 0; i < golden.size(); i++)
+        {
+            names.push_back(golden[i].name);
+        }
+    }
+    if (names.empty())
+    {
+        std::cerr << "No input images" << std::endl;
+        return 1;
+    }
+
+    // Initialize the library
+    SaConfig config={};
+    std::memset(&config,0,sizeof(SaConfig));
+    config.struct_size = sizeof(SaConfig);
+    config.computation_mode = options.computation_mode;
+    config.gpu_device_id = 0;
+    config.num_threads = options.sdk_threads;
+    config.precision = options.precision;
+    config.cpu_dispatch = options.cpu_dispatch;
+
+    SAState sa_state;
+    if (api.saInit(options.config_filename.c_str(), &config, &sa_state) != 0)
+    {
+        return 1;
+    }
+
+    std::vector<ERImage> images(names.size());
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        std::string filename = options.images_dir + "/" + names[i];
+        if (api.erImageRead(&images[i], filename.c_str()) != 0)
+        {
+            std::cerr << "Can't load the file: " << filename << std::endl;
+            for (size_t j = 0; j < i; j++)
+            {
+                api.erImageFree(&images[j]);
+            }
+            api.saFree(sa_state);
+            return 1;
+        }
+    }
+
+    // Every worker thread gets its own state, the images are distributed round-robin
+    std::vector<SAState> states(1, sa_state);
+    for (int t = 1; t < options.threads; t++)
+    {
+        SAState sa_state_clone;
+        if (api.saCloneState(sa_state, &sa_state_clone) != 0)
+        {
+            break;
+        }
+        states.push_back(sa_state_clone);
+    }
+
+    std::vector<ImageResult> results(names.size());
+    std::vector<std::vector<SaSclResult> > golden_scl_results(names.size());
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < states.size(); t++)
+    {
+        workers.push_back(std::thread(processImages, &api, states[t], &images,
+            options.record ? nullptr : &golden, t, states.size(), &results, &golden_scl_results));
+    }
+    for (size_t t = 0; t < workers.size(); t++)
+    {
+        workers[t].join();
+    }
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        results[i].name = names[i];
+    }
+
+    int return_value = 0;
+    if (options.record)
+    {
+        size_t num_failed = 0;
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            num_failed += results[i].ok ? 0 : 1;
+        }
+        if (num_failed > 0 || !writeGolden(options.golden_filename, results))
+        {
+            std::cerr << "Recording of the golden output failed" << std::endl;
+            return_value = 1;
+        }
+        else
+        {
+            printf("Golden output of %zu images written to %s\n", results.size(), options.golden_filename.c_str());
+        }
+    }
+    else
+    {
+        int num_failures = 0;
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            num_failures += compareImage(golden[i], results[i], golden_scl_results[i], options);
+        }
+        printf("%zu images, %d threads: %s (%d differences)\n", results.size(), (int)states.size(),
+            num_failures == 0 ? "PASSED" : "FAILED", num_failures);
+        return_value = num_failures == 0 ? 0 : 1;
+    }
+
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        api.erImageFree(&images[i]);
+    }
+
+    // Free the clones and the SDK state
+    for (size_t t = 0; t < states.size(); t++)
+    {
+        api.saFree(states[t]);
+    }
+    return return_value;
+}
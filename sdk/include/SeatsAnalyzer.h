@@ -43,21 +43,63 @@ ER_FUNCTION_PREFIX const char* saVersion();
 /** Initializes the library and sets up \p sa_state to point to the library instance.
  * Can be initialized using a configuration file or a SaConfig structure.
  * The SaConfig structure can be used to overried values defined in configuration files.
+ * With SaConfig.model_load_mode set to SA_MODEL_LOAD_MMAP, the models are memory-mapped instead of read, \see saGetInitTiming.
  *
  * \param[in] sa_config_path path to SeatsAnalyzer configuration file
- * \param[in] sa_config SaConfig configuration structure, set NULL for default configuration using configuration file (sa_config_path)
+ * \param[in] sa_config SaConfig configuration structure with SaConfig.struct_size set, set NULL for default configuration using configuration file (sa_config_path)
  * \param[out] sa_state Initialized SeatsAnalyzer state
  * \return Returns a non-zero error code if initialization failed.
  * \snippet example.cpp Init */
 ER_FUNCTION_PREFIX int saInit(const char *sa_config_path, const SaConfig* sa_config,  SAState *sa_state);
 
+/** Returns the timing breakdown of the saInit() call which created the state.
+ * Cloned states report the timing of the source state.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[out] timing Durations of the loading phases
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_init.cpp InitTiming */
+ER_FUNCTION_PREFIX int saGetInitTiming(SAState sa_state, SaInitTiming *timing);
+
+/** Creates a new SeatsAnalyzer state sharing the loaded models with \p sa_state.
+ * The clone shares the detector plugin, the classification model and the p-table with the source state,
+ * only the per-call scratch buffers are allocated for it, so cloning is much cheaper than another saInit() call.
+ *
+ * A single state must not be used by several threads at the same time, use one clone per worker thread instead.
+ * Clones can be used concurrently with each other and with the source state. Each clone has to be freed by saFree(),
+ * the shared models are released together with the last state referencing them, regardless of the order.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[out] sa_state_clone Cloned SeatsAnalyzer state
+ * \return Returns a non-zero error code if cloning failed.
+ * \snippet example_threads.cpp Clone */
+ER_FUNCTION_PREFIX int saCloneState(SAState sa_state, SAState *sa_state_clone);
+
+/** Reloads the detection and classification models without tearing down the state.
+ * The new models are loaded by the calling thread while the state and its clones keep processing with the current models.
+ * The call is synchronous, to load in the background call it from a thread of your own, e.g. a maintenance thread.
+ * Then they are swapped in atomically: calls in progress finish with the old models, calls started after the swap use
+ * the new ones, and the old models are released when no call references them anymore. Unlike other functions, it may be
+ * called while another thread is using \p sa_state. The models are replaced for the state and all its clones.
+ * If loading fails, the current models are kept.
+ *
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] sa_config_path path to SeatsAnalyzer configuration file, set NULL to use the path given to saInit()
+ * \param[in] sa_config SaConfig configuration structure with SaConfig.struct_size set, set NULL for configuration file only, only the model paths and
+ *                      SaConfig.model_load_mode are used, the computation settings of the state are kept
+ * \return Returns a non-zero error code if loading of the new models failed.
+ * \snippet example_reload.cpp Reload */
+ER_FUNCTION_PREFIX int saReloadModels(SAState sa_state, const char *sa_config_path, const SaConfig* sa_config);
+
 /** Frees SeatsAnalyzer state.
+ * Waits for all pending asynchronous tasks of the state, results which were not collected are released.
  * \param[in] sa_state Initialized SeatsAnalyzer state
  * \snippet example.cpp Free */
 ER_FUNCTION_PREFIX void saFree(SAState sa_state);
 
 /** Runs windshield detections and sets the provided SaDetResult.
  * Has to be freed using saFreeDetResult.
+ * The input image can be BGR, BGRA, RGB, RGBA or gray, the channels are reordered during resizing. Any row step is accepted,
+ * so images wrapped by erImageAllocateAndWrap() around a caller's buffer are processed without a copy. YCbCr 4:2:0 images (ER_IMAGE_COLORMODEL_YCBCR420 and ER_IMAGE_COLORMODEL_YCBCRNV12)
+ * are accepted as well and converted directly into the network input together with resizing, i.e. without a full-resolution BGR copy.
  * \param[in] sa_state Initialized SeatsAnalyzer state
  * \param[in] image Input image
  * \param[in] bounding_box Region of Interest for detection, set NULL if not used
@@ -66,6 +108,33 @@ ER_FUNCTION_PREFIX void saFree(SAState sa_state);
  * \snippet example.cpp Det */
 ER_FUNCTION_PREFIX int saRunDet(SAState sa_state, const ERImage image, const ERRoI *bounding_box, SaDetResult *result);
 
+/** Runs windshield detections on a batch of images and sets one SaDetResult per image.
+ * All images are passed through the detection network as a single batch, which is considerably faster
+ * than calling saRunDet() for each image separately. Every result has to be freed using saFreeDetResult.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] images Array of \p num_images input images
+ * \param[in] bounding_boxes Array of \p num_images Regions of Interest for detection, set NULL if not used for any image, single elements can be NULL as well
+ * \param[in] num_images Number of images in the batch
+ * \param[out] results Array of \p num_images detection results, results[i] corresponds to images[i]
+ * \return Returns zero on success or error code otherwise. No result has to be freed if an error is returned.
+ * \snippet example_batch.cpp DetBatch */
+ER_FUNCTION_PREFIX int saRunDetBatch(SAState sa_state, const ERImage *images, const ERRoI * const *bounding_boxes, int num_images, SaDetResult *results);
+
+/** Runs windshield detections and writes them into a caller-owned array.
+ * Same as saRunDet(), but the result is not allocated and needs not to be freed. Together with the per-call scratch buffers,
+ * which are kept in the state and reused, no heap allocation is done once the buffers are large enough for the processed images.
+ * If the array is too small, the first \p capacity detections are written, \p num_detections is set to the required
+ * number of elements and SA_RESULT_BUFFER_TOO_SMALL is returned.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] image Input image
+ * \param[in] bounding_box Region of Interest for detection, set NULL if not used
+ * \param[out] detections Caller-owned array of at least \p capacity elements
+ * \param[in] capacity Number of elements of \p detections
+ * \param[out] num_detections Number of detections found
+ * \return Returns zero on success, SA_RESULT_BUFFER_TOO_SMALL if more than \p capacity detections were found, or error code otherwise.
+ * \snippet example_buffers.cpp DetInto */
+ER_FUNCTION_PREFIX int saRunDetInto(SAState sa_state, const ERImage image, const ERRoI *bounding_box, SaDetection *detections, int capacity, int *num_detections);
+
 /** Frees SaDetResult.
  * \param[in] sa_state SeatsAnalyzer state which was used for obtaining detection_result.
  * \param[in] detection_result SaDetResult structure to be freed.
@@ -73,6 +142,9 @@ ER_FUNCTION_PREFIX int saRunDet(SAState sa_state, const ERImage image, const ERR
 ER_FUNCTION_PREFIX void saFreeDetResult(SAState sa_state, SaDetResult *detection_result);
 
 /** Runs seats classification for the input SaBoundingBox crop and returns SaSclResult.
+ * The same input color models as for saRunDet() are supported, for YCbCr 4:2:0 images only the crop is converted.
+ * Only the tasks selected by SaConfig.scl_task_mask are computed, \see saRunSclMasked.
+ * With SaConfig.scl_cascade enabled, driver, belt and phone of empty or low-quality positions are set to '?' without inference.
  * \warning Only SaDetectionLabel with value "window" is currently supported, other values will return an error.
  *
  * \param[in] sa_state Initialized SeatsAnalyzer state
@@ -83,6 +155,260 @@ ER_FUNCTION_PREFIX void saFreeDetResult(SAState sa_state, SaDetResult *detection
  * \return Returns zero on success or error code otherwise.
  * \snippet example.cpp Scl */
 ER_FUNCTION_PREFIX int saRunScl(SAState sa_state, const ERImage image, const ERRotatedRect *position, const SaDetectionLabel detection_label, SaSclResult *result);
+
+/** Runs seats classification of the selected tasks only and returns SaSclResult.
+ * Same as saRunScl(), but \p task_mask is used instead of SaConfig.scl_task_mask for this call.
+ * \warning Only SaDetectionLabel with value "window" is currently supported, other values will return an error.
+ *
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] image Input image
+ * \param[in] position Detection position, result of saRunDet(), \see SaDetResult
+ * \param[in] detection_label Detection label, \see SaDetResult
+ * \param[in] task_mask Classification tasks to compute, \see SA_SCL_TASK_MASK, zero for all tasks
+ * \param[out] result SaSclResult structure, results of the disabled tasks are left empty
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_task_mask.cpp SclMasked */
+ER_FUNCTION_PREFIX int saRunSclMasked(SAState sa_state, const ERImage image, const ERRotatedRect *position, const SaDetectionLabel detection_label, unsigned int task_mask, SaSclResult *result);
+
+/** Runs seats classification for a batch of windshield crops and fills one SaSclResult per crop.
+ * The crops may come from several images, all of them are passed through the classification network as a single batch.
+ * \warning Only SaDetectionLabel with value "window" is currently supported, other values will return an error.
+ *
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] images Array of \p num_images input images
+ * \param[in] num_images Number of input images
+ * \param[in] image_indices Array of \p num_crops indices to \p images, the crop i is taken from images[image_indices[i]]
+ * \param[in] positions Array of \p num_crops detection positions, results of saRunDet() or saRunDetBatch(), \see SaDetResult
+ * \param[in] detection_labels Array of \p num_crops detection labels, \see SaDetResult
+ * \param[in] num_crops Number of crops to classify
+ * \param[out] results Array of \p num_crops SaSclResult structures, results[i] corresponds to positions[i]
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_batch.cpp SclBatch */
+ER_FUNCTION_PREFIX int saRunSclBatch(SAState sa_state, const ERImage *images, int num_images, const int *image_indices, const ERRotatedRect *positions, const SaDetectionLabel *detection_labels, int num_crops, SaSclResult *results);
+
+/** Runs windshield detection followed by seats classification of every supported detection and sets the provided SaFullResult.
+ * Equivalent to saRunDet() followed by saRunScl() for each "window" detection, but the input image is validated and
+ * converted only once and its preprocessed planes are shared by both stages.
+ * Has to be freed using saFreeFullResult.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] image Input image
+ * \param[in] bounding_box Region of Interest for detection, set NULL if not used
+ * \param[out] result Detection and classification result
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_fused.cpp DetScl */
+ER_FUNCTION_PREFIX int saRunDetScl(SAState sa_state, const ERImage image, const ERRoI *bounding_box, SaFullResult *result);
+
+/** Runs windshield detection on a reduced-resolution image followed by seats classification on a full-resolution image.
+ * Same as saRunDetScl(), but the detector processes \p det_image, e.g. a preview sub-stream of the camera, without
+ * downscaling the full-resolution frame, and the detected positions are mapped to \p scl_image for classification.
+ * The positions in the result are in \p scl_image coordinates.
+ * Has to be freed using saFreeFullResult.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] det_image Input image for detection
+ * \param[in] scl_image Input image for classification showing the same scene as \p det_image
+ * \param[in] mapping Mapping from \p det_image to \p scl_image coordinates, set NULL to derive the scale from the image sizes
+ * \param[in] bounding_box Region of Interest for detection in \p det_image coordinates, set NULL if not used
+ * \param[out] result Detection and classification result
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_dual.cpp DetSclDual */
+ER_FUNCTION_PREFIX int saRunDetSclDual(SAState sa_state, const ERImage det_image, const ERImage scl_image, const SaScaleMapping *mapping, const ERRoI *bounding_box, SaFullResult *result);
+
+/** Frees SaFullResult.
+ * \param[in] sa_state SeatsAnalyzer state which was used for obtaining full_result.
+ * \param[in] full_result SaFullResult structure to be freed.
+ * \snippet example_fused.cpp DetSclFree */
+ER_FUNCTION_PREFIX void saFreeFullResult(SAState sa_state, SaFullResult *full_result);
+
+/** Maps a position between the detection and classification image coordinates.
+ * The center and size are scaled and offset, the angle is adjusted for a non-uniform scale so the mapped rectangle
+ * covers the same image content. Allows to run saRunDet() on a reduced-resolution image and saRunScl() on
+ * a full-resolution image, which then has to be decoded only when a windshield is present.
+ * \param[in] mapping Mapping from the detection image to the classification image coordinates
+ * \param[in] position Position to map
+ * \param[in] inverse Zero to map from the detection image to the classification image, non-zero for the opposite direction
+ * \param[out] mapped Mapped position, may be the same as \p position
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_dual.cpp MapRotatedRect */
+ER_FUNCTION_PREFIX int saMapRotatedRect(const SaScaleMapping *mapping, const ERRotatedRect *position, int inverse, ERRotatedRect *mapped);
+
+/** Returns per-stage counters and latency percentiles accumulated since saInit() or the last saResetStats().
+ * The statistics are shared by the state and its clones. Unlike processing functions, it may be called
+ * while other threads are using the state, e.g. by a monitoring thread.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[out] stats Processing statistics
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example.cpp Stats */
+ER_FUNCTION_PREFIX int saGetStats(SAState sa_state, SaStats *stats);
+
+/** Resets the processing statistics of the state and its clones.
+ * \param[in] sa_state Initialized SeatsAnalyzer state */
+ER_FUNCTION_PREFIX void saResetStats(SAState sa_state);
+
+/** Starts recording of trace spans.
+ * Begin and end of every API call and of every processing stage (\see SaStage) of the state and its clones are recorded
+ * into per-thread lock-free ring buffers, the oldest spans are overwritten when a buffer is full.
+ * When tracing is not started, each span costs a single branch.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] max_events_per_thread Capacity of the per-thread ring buffers, zero for default
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_threads.cpp TraceStart */
+ER_FUNCTION_PREFIX int saTraceStart(SAState sa_state, unsigned int max_events_per_thread);
+
+/** Stops recording of trace spans and writes them to a file.
+ * The file is in Chrome trace event JSON format, which can be opened in Perfetto UI or chrome://tracing.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] trace_filename Output JSON file, set NULL to discard the recorded spans
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_threads.cpp TraceStop */
+ER_FUNCTION_PREFIX int saTraceStop(SAState sa_state, const char *trace_filename);
+
+/** Returns counters of the classification cascade accumulated since saInit() or the last saResetCascadeStats().
+ * The counters are shared by the state and its clones, \see SaCascadeStats.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[out] stats Cascade counters
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_cascade.cpp CascadeStats */
+ER_FUNCTION_PREFIX int saGetCascadeStats(SAState sa_state, SaCascadeStats *stats);
+
+/** Resets counters of the classification cascade of the state and its clones.
+ * \param[in] sa_state Initialized SeatsAnalyzer state */
+ER_FUNCTION_PREFIX void saResetCascadeStats(SAState sa_state);
+
+/** Runs windshield detections and writes them in the compact layout into a caller-owned array.
+ * Compact counterpart of saRunDetInto(), labels are returned as SaLabelId, \see saGetLabelName.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] image Input image
+ * \param[in] bounding_box Region of Interest for detection, set NULL if not used
+ * \param[out] detections Caller-owned array of at least \p capacity elements
+ * \param[in] capacity Number of elements of \p detections
+ * \param[out] num_detections Number of detections found
+ * \return Returns zero on success, SA_RESULT_BUFFER_TOO_SMALL if more than \p capacity detections were found, or error code otherwise.
+ * \snippet example_compact.cpp DetCompact */
+ER_FUNCTION_PREFIX int saRunDetCompact(SAState sa_state, const ERImage image, const ERRoI *bounding_box, SaCompactDetection *detections, int capacity, int *num_detections);
+
+/** Runs seats classification and returns the result in the compact layout.
+ * Compact counterpart of saRunScl().
+ * \warning Only the label "window" is currently supported, other values will return an error.
+ *
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] image Input image
+ * \param[in] position Detection position, result of saRunDetCompact()
+ * \param[in] label_id Detection label, \see SaCompactDetection
+ * \param[out] result Compact seats classification of the windshield
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_compact.cpp SclCompact */
+ER_FUNCTION_PREFIX int saRunSclCompact(SAState sa_state, const ERImage image, const ERRotatedRect *position, SaLabelId label_id, SaCompactSclResult *result);
+
+/** Returns the string label corresponding to the numeric label.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] label_id Numeric label
+ * \return Returns the label string owned by the state, or NULL for an unknown label. */
+ER_FUNCTION_PREFIX const char* saGetLabelName(SAState sa_state, SaLabelId label_id);
+
+/** Returns the numeric label corresponding to the string label.
+ * The returned id is valid only until the next saReloadModels(), \see SaLabelId.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] label String label, e.g. "window"
+ * \return Returns the numeric label, or a negative value for an unknown label. */
+ER_FUNCTION_PREFIX SaLabelId saGetLabelId(SAState sa_state, const char *label);
+
+/** Creates a video stream on top of the SeatsAnalyzer state.
+ * The stream tracks windshields across consecutive frames of one camera. Most frames are searched only in RoIs predicted
+ * from the tracks, full-frame detection is run every SaStreamConfig.redetect_interval frames. Each track is classified
+ * once, from its best-quality frame, when it is finished.
+ * For static cameras, the optional scene change gate (SaStreamConfig.change_gate) compares a downsampled luma of each frame
+ * against a background model and skips the detection while nothing has changed and no track is active. The background is
+ * blended with every frame without an active track, skipped or processed, so that it follows gradual lighting changes.
+ * Sudden global changes are absorbed by replacing the background after SaStreamConfig.change_gate_refresh_interval
+ * consecutive processed frames without a track.
+ * The stream uses \p sa_state for the computation, i.e. the state must not be used by another thread at the same time,
+ * \see saCloneState. The state must be freed after the stream.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] stream_config Stream configuration, set NULL for default configuration
+ * \param[out] sa_stream Initialized video stream
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_stream.cpp StreamCreate */
+ER_FUNCTION_PREFIX int saStreamCreate(SAState sa_state, const SaStreamConfig *stream_config, SAStream *sa_stream);
+
+/** Frees the video stream.
+ * \param[in] sa_stream Initialized video stream */
+ER_FUNCTION_PREFIX void saStreamFree(SAStream sa_stream);
+
+/** Processes the next frame of the video stream and sets the provided SaStreamResult.
+ * The crop around the best-quality detection of each track is copied, the frame can be released after the call.
+ * Has to be freed using saFreeStreamResult.
+ * \param[in] sa_stream Initialized video stream
+ * \param[in] image Next frame of the stream
+ * \param[out] result Tracks active in the frame and tracks finished by the frame
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_stream.cpp StreamProcess */
+ER_FUNCTION_PREFIX int saStreamProcess(SAStream sa_stream, const ERImage image, SaStreamResult *result);
+
+/** Finishes and classifies all active tracks of the video stream, e.g. at the end of the stream.
+ * Has to be freed using saFreeStreamResult.
+ * \param[in] sa_stream Initialized video stream
+ * \param[out] result Finished tracks
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_stream.cpp StreamFlush */
+ER_FUNCTION_PREFIX int saStreamFlush(SAStream sa_stream, SaStreamResult *result);
+
+/** Frees SaStreamResult.
+ * \param[in] sa_stream Video stream which was used for obtaining stream_result.
+ * \param[in] stream_result SaStreamResult structure to be freed. */
+ER_FUNCTION_PREFIX void saFreeStreamResult(SAStream sa_stream, SaStreamResult *stream_result);
+
+/** Returns counters of the video stream.
+ * \param[in] sa_stream Initialized video stream
+ * \param[out] stats Stream counters
+ * \return Returns zero on success or error code otherwise. */
+ER_FUNCTION_PREFIX int saStreamGetStats(SAStream sa_stream, SaStreamStats *stats);
+
+/** Submits windshield detection to the internal work queue and returns immediately.
+ * The task is processed by one of SaConfig.num_threads workers of the state. The image data must stay valid and unchanged
+ * until the task is finished, the bounding box is copied. If \p callback is NULL, the result has to be collected
+ * by saPoll() or saWait(), otherwise it is passed to the callback and the ticket cannot be polled.
+ * The call blocks while 2 * SaConfig.num_threads tasks of the state are pending.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] image Input image
+ * \param[in] bounding_box Region of Interest for detection, set NULL if not used
+ * \param[in] callback Completion callback, set NULL to collect the result by saPoll() or saWait()
+ * \param[in] user_data User pointer passed to the callback
+ * \param[out] ticket Identifier of the submitted task
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_async.cpp SubmitDet */
+ER_FUNCTION_PREFIX int saSubmitDet(SAState sa_state, const ERImage image, const ERRoI *bounding_box, fcn_saCompletionCallback callback, void *user_data, SaTicket *ticket);
+
+/** Submits seats classification to the internal work queue and returns immediately.
+ * Asynchronous counterpart of saRunScl(), the same rules as for saSubmitDet() apply. The position and the label are copied.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] image Input image
+ * \param[in] position Detection position, result of saRunDet(), \see SaDetResult
+ * \param[in] detection_label Detection label, \see SaDetResult
+ * \param[in] callback Completion callback, set NULL to collect the result by saPoll() or saWait()
+ * \param[in] user_data User pointer passed to the callback
+ * \param[out] ticket Identifier of the submitted task
+ * \return Returns zero on success or error code otherwise.
+ * \snippet example_async.cpp SubmitScl */
+ER_FUNCTION_PREFIX int saSubmitScl(SAState sa_state, const ERImage image, const ERRotatedRect *position, const SaDetectionLabel detection_label, fcn_saCompletionCallback callback, void *user_data, SaTicket *ticket);
+
+/** Checks whether an asynchronous task is finished without blocking.
+ * If the task is finished, its result is moved to \p result and the ticket is released.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] ticket Identifier of the task returned by saSubmitDet() or saSubmitScl()
+ * \param[out] result Result of the task, \see SaTaskResult
+ * \return Returns zero if the task is finished, SA_RESULT_PENDING if not, or error code otherwise (e.g. unknown ticket).
+ * \snippet example_async.cpp Poll */
+ER_FUNCTION_PREFIX int saPoll(SAState sa_state, SaTicket ticket, SaTaskResult *result);
+
+/** Waits until an asynchronous task is finished.
+ * If the task is finished, its result is moved to \p result and the ticket is released.
+ * \param[in] sa_state Initialized SeatsAnalyzer state
+ * \param[in] ticket Identifier of the task returned by saSubmitDet() or saSubmitScl()
+ * \param[in] timeout_ms Maximal waiting time in milliseconds, negative value waits without limit
+ * \param[out] result Result of the task, \see SaTaskResult
+ * \return Returns zero if the task is finished, SA_RESULT_TIMEOUT if the timeout expired, or error code otherwise.
+ * \snippet example_async.cpp Wait */
+ER_FUNCTION_PREFIX int saWait(SAState sa_state, SaTicket ticket, int timeout_ms, SaTaskResult *result);
 /** @} */
 
 #if defined(CPP) || defined(__cplusplus) || defined(c_plusplus)
@@ -23,6 +23,8 @@
 #ifndef _SA_TYPE_H_
 #define _SA_TYPE_H_
 
+#include <stdint.h>
+
 #include "er_image.h"
 #include "er_type.h"
 
@@ -32,31 +34,150 @@
 #define NUM_CONF_OUTPUTS 3
 /** @endcond */
 
+/** \defgroup SA_RETURN_CODES SA return codes
+ * @{ Return codes with a special meaning, any other non-zero value signifies an error. */
+#define SA_RESULT_PENDING 1000 /**< The asynchronous task has not been finished yet, \see saPoll */
+#define SA_RESULT_TIMEOUT 1001 /**< The asynchronous task has not been finished within the timeout, \see saWait */
+#define SA_RESULT_BUFFER_TOO_SMALL 1002 /**< The caller-provided buffer is too small, the required number of elements is returned, \see saRunDetInto */
+#define SA_RESULT_CONFIG_SIZE_MISMATCH 1003 /**< SaConfig.struct_size is not set or not supported by the library, \see SaConfig */
+/** @} */
+
 
 
 /** \defgroup SA_TYPES SA Type definitions
  * @{ Structs and type definitions used in the package */
 
 /** Pointer to SeatsAnalyzer module state
- * \see saInit, saFree */
+ * \see saInit, saCloneState, saFree */
 typedef void *SAState;
 
+/** Timing breakdown of saInit()
+ * \see saGetInitTiming */
+typedef struct
+{
+    double total_ms;      /**< Total duration of saInit() */
+    double config_ms;     /**< Parsing of the configuration files */
+    double det_plugin_ms; /**< Loading of the detector plugin and its model */
+    double scl_model_ms;  /**< Loading of the classification model */
+    double p_table_ms;    /**< Loading of the p-table */
+    double warmup_ms;     /**< First inference and allocation of the scratch buffers */
+    int    det_mapped;    /**< Non-zero if the detector model is memory-mapped */
+    int    scl_mapped;    /**< Non-zero if the classification model and the p-table are memory-mapped */
+} SaInitTiming;
+
+/** Processing stages measured by saGetStats()
+ * \see SaStats */
+typedef enum
+{
+    SA_STAGE_DET_PREPROCESS  = 0, /**< Detection input validation, conversion and resizing */
+    SA_STAGE_DET_INFERENCE   = 1, /**< Detection network inference */
+    SA_STAGE_DET_POSTPROCESS = 2, /**< Detection decoding and non-maximum suppression */
+    SA_STAGE_SCL_CROP        = 3, /**< Classification crop warping and normalization */
+    SA_STAGE_SCL_INFERENCE   = 4, /**< Classification network inference */
+    SA_STAGE_SCL_P_TABLE     = 5  /**< Classification p-table lookup */
+} SaStage;
+
+/** @cond */
+#define SA_NUM_STAGES 6
+/** @endcond */
+
+/** Counters and latency of one processing stage
+ * The percentiles are estimated from a histogram with logarithmic buckets, their relative error is below 5 %.
+ * \see SaStats */
+typedef struct
+{
+    unsigned long long count;    /**< Number of stage runs */
+    double             total_ms; /**< Total duration of all runs */
+    double             p50_ms;   /**< Median duration */
+    double             p95_ms;   /**< 95th percentile of the duration */
+    double             p99_ms;   /**< 99th percentile of the duration */
+    double             max_ms;   /**< Maximal duration */
+} SaStageStats;
+
+/** Processing statistics
+ * Collected by the state and its clones together using relaxed atomic counters, always enabled.
+ * \see saGetStats, saResetStats */
+typedef struct
+{
+    SaStageStats       stages[SA_NUM_STAGES]; /**< Statistics indexed by SaStage */
+    unsigned long long num_allocations;       /**< Number of heap allocations done by the processing calls */
+    unsigned long long bytes_allocated;       /**< Bytes allocated by the processing calls */
+} SaStats;
+
+/** Pointer to SeatsAnalyzer video stream state
+ * \see saStreamCreate, saStreamFree */
+typedef void *SAStream;
+
 /** Detection label
  *
  * Fixed length char array that holds information concerning the type of the detection, for example "window"
  * \see saRunScl, SaDetection */
 typedef char SaDetectionLabel[SA_LABEL_STRING_LENGTH];
 
+/** \defgroup SA_SCL_TASK_MASK Classification task mask
+ * @{ Bitmask selecting the classification tasks computed for each seat position.
+ * Task bits are shifted by the position macros, e.g. SA_SCL_ALL_POSITIONS(SA_SCL_TASK_BELT) computes belts only and
+ * SA_SCL_LEFT(SA_SCL_TASK_OCCUPIED | SA_SCL_TASK_BELT) | SA_SCL_RIGHT(SA_SCL_TASK_PHONE) computes belt on the left and phone on the right.
+ * Crops, network branches and p-table lookups of the disabled tasks are skipped, their SaClass.result is left empty.
+ * \see SaConfig, saRunSclMasked */
+#define SA_SCL_TASK_OCCUPIED 0x1 /**< SaPosition.occupied */
+#define SA_SCL_TASK_DRIVER   0x2 /**< SaPosition.driver */
+#define SA_SCL_TASK_BELT     0x4 /**< SaPosition.belt */
+#define SA_SCL_TASK_PHONE    0x8 /**< SaPosition.phone */
+#define SA_SCL_TASK_ALL      0xF /**< All tasks */
+#define SA_SCL_LEFT(tasks)   ((unsigned int)(tasks) << 0) /**< Tasks for SaSclResult.left */
+#define SA_SCL_MIDDLE(tasks) ((unsigned int)(tasks) << 4) /**< Tasks for SaSclResult.middle */
+#define SA_SCL_RIGHT(tasks)  ((unsigned int)(tasks) << 8) /**< Tasks for SaSclResult.right */
+#define SA_SCL_ALL_POSITIONS(tasks) (SA_SCL_LEFT(tasks) | SA_SCL_MIDDLE(tasks) | SA_SCL_RIGHT(tasks)) /**< Tasks for all positions */
+/** @} */
+
 /** External inference callback interface
  *  The input of the callback is ERImage. The data memeber corresponds to input buffer for inferece.
  *  The output buffer is pre-allocated in SeatsAnalyzer SDK.
  */
 typedef int  (*fcn_saInferenceCallback) (const ERImage*, unsigned char*);
 
+/** Model loading mode
+ * \see SaConfig */
+typedef enum
+{
+    SA_MODEL_LOAD_HEAP = 0, /**< Models are read into private heap memory of the process */
+    SA_MODEL_LOAD_MMAP = 1  /**< Models are memory-mapped read-only and used in place, the physical pages are shared by all processes
+                                 using the same model files. Requires models in the mappable format, other model files are read into heap. */
+} SaModelLoadMode;
+
+/** Instruction set of the CPU image kernels
+ * The classification crop (rotated warp, bilinear sampling, channel reorder and normalization in one pass)
+ * and the detection resize use the selected kernels. saInit() fails if the requested instruction set is not supported by the CPU.
+ * \see SaConfig, SA_STAGE_SCL_CROP */
+typedef enum
+{
+    SA_CPU_DISPATCH_AUTO   = 0, /**< The best instruction set supported by the CPU is detected at runtime */
+    SA_CPU_DISPATCH_SCALAR = 1, /**< Portable scalar kernels, the reference implementation */
+    SA_CPU_DISPATCH_SSE4   = 2, /**< SSE4.1 kernels */
+    SA_CPU_DISPATCH_AVX2   = 3  /**< AVX2 and FMA kernels */
+} SaCpuDispatch;
+
+/** Numerical precision of the network inference
+ * \see SaConfig */
+typedef enum
+{
+    SA_PRECISION_FP32 = 0, /**< 32-bit floating point models, the reference precision */
+    SA_PRECISION_INT8 = 1  /**< 8-bit quantized models with integer kernels (AVX-VNNI/AVX512-VNNI if available, AVX2 otherwise).
+                                Supported by ER_COMPUTATION_MODE_CPU only, saInit() fails if the quantized models are not found or the CPU does not support AVX2. */
+} SaPrecision;
+
 /** Configuration structures
  *
  * By default, the SeatsAnalyzer SDK is configured by configuration files pointed by sa_config_path parameter of saInit() function.
  * The SaConfig structure serves to override this default setup.
+ *
+ * The members following scl_inference_output_buffer_size were added after the initial release. struct_size has to be set
+ * to sizeof(SaConfig) so that the library reads only the members present in the caller's structure: members missing
+ * in a smaller structure of an older header take their default values, and saInit() and saReloadModels() fail with
+ * SA_RESULT_CONFIG_SIZE_MISMATCH if struct_size is zero or larger than the structure known to the library.
+ * Binaries built against the initial header, which has no struct_size member, must be rebuilt against the header
+ * matching the library before passing SaConfig.
  * \see saInit */
 typedef struct
 {
@@ -73,7 +194,7 @@ typedef struct
     // global modifications
     ERComputationMode computation_mode;  /**< Computation mode of the project */
     int gpu_device_id;  /**< GPU device id to use for computation, only used if computation_mode == 1 */
-    int num_threads;  /**< Number of threads to use */
+    int num_threads;  /**< Number of threads to use, also the number of workers processing asynchronous tasks, \see saSubmitDet */
 
     // External inference interface
     fcn_saInferenceCallback det_inference_callback;           /**< Callback funtion for external detection network inference  (if NULL, external inferece is not used) */
@@ -81,6 +202,29 @@ typedef struct
     fcn_saInferenceCallback scl_inference_callback;           /**< Callback funtion for external scl net inference (if NULL, external inferece is not used) */
     unsigned int            scl_inference_output_buffer_size; /**< Byte size of output buffer from scl inference */
 
+    // layout version
+    unsigned int struct_size;  /**< Has to be set to sizeof(SaConfig), \see SA_RESULT_CONFIG_SIZE_MISMATCH */
+
+    // classification tasks
+    unsigned int scl_task_mask;  /**< Classification tasks computed by default, \see SA_SCL_TASK_MASK, zero for all tasks */
+
+    // classification cascade
+    int   scl_cascade;                        /**< Non-zero to skip driver, belt and phone of empty or low-quality positions, \see SaCascadeStats */
+    float scl_cascade_min_quality;            /**< Positions with SaPosition.quality below this threshold are not classified further */
+    float scl_cascade_min_occupied_confidence; /**< Positions not occupied with at least this confidence are not classified further, applied only if the occupied task of the position is enabled */
+
+    // model loading
+    SaModelLoadMode model_load_mode; /**< Model loading mode, \see SaModelLoadMode */
+
+    // tracing
+    const char* trace_filename;  /**< Chrome trace JSON file written by saFree(), tracing is enabled from saInit() if set (optional, set NULL to disable), \see saTraceStart */
+
+    // image kernels
+    SaCpuDispatch cpu_dispatch;  /**< Instruction set of the CPU image kernels, \see SaCpuDispatch */
+
+    // inference precision
+    SaPrecision precision;  /**< Numerical precision of the detection and classification inference, \see SaPrecision */
+
 } SaConfig;
 
 /** Bounding-box coordinates structure
@@ -111,8 +255,8 @@ typedef struct
 
 /** Array of SaDetection elements.
  * The structure holds an array of all object detections. The array is dynamically
- * allocated in saRunDet function and must be released by the saFreeDetResult function.
- * \see saRunDet */
+ * allocated in saRunDet (or saRunDetBatch) function and must be released by the saFreeDetResult function.
+ * \see saRunDet, saRunDetBatch */
 typedef struct
 {
     int             num_detections; /**< Number of detections */
@@ -156,13 +300,210 @@ typedef struct
  * left - occupied, driver, belt \n
  * middle - occupied \n
  * right - occupied, driver, belt, phone
- * \see saRunScl */
+ * \see saRunScl, saRunSclBatch */
 typedef struct
 {
     SaPosition  left; /**< Left position in the vehicle from the perspective of the camera. */
     SaPosition  middle; /**< Middle position in the vehicle from the perspective of the camera. */
     SaPosition  right; /**< Right position in the vehicle from the perspective of the camera. */
 } SaSclResult;
+
+/** Structure with data related to a single detected object and its seats classification.
+ * \see SaFullResult */
+typedef struct
+{
+    SaDetection         detection;  /**< Detected object */
+    int                 has_scl;    /**< Non-zero if scl_result is set, zero if the detection label is not supported by classification */
+    SaSclResult         scl_result; /**< Seats classification of the detected object, valid only if has_scl is non-zero */
+} SaFullDetection;
+
+/** Array of SaFullDetection elements.
+ * The structure holds an array of all object detections together with their classification. The array is dynamically
+ * allocated in saRunDetScl or saRunDetSclDual function and must be released by the saFreeFullResult function.
+ * \see saRunDetScl, saRunDetSclDual */
+typedef struct
+{
+    int                 num_detections; /**< Number of detections */
+    SaFullDetection    *detections; /**< Array of detections */
+} SaFullResult;
+
+/** Mapping between the coordinate spaces of a reduced-resolution detection image and a full-resolution classification image.
+ * A point (x, y) of the detection image corresponds to the point (x * scale_x + offset_x, y * scale_y + offset_y)
+ * of the classification image, e.g. scale 4 for a quarter-resolution sub-stream of the same camera.
+ * \see saRunDetSclDual, saMapRotatedRect */
+typedef struct
+{
+    float               scale_x;    /**< Horizontal scale from the detection image to the classification image */
+    float               scale_y;    /**< Vertical scale from the detection image to the classification image */
+    float               offset_x;   /**< Horizontal offset in classification image pixels, non-zero e.g. for a cropped sub-stream */
+    float               offset_y;   /**< Vertical offset in classification image pixels */
+} SaScaleMapping;
+
+/** Counters of the classification cascade.
+ * When SaConfig.scl_cascade is enabled, driver, belt and phone of a position are set to '?' without running
+ * their inference if the position quality or occupancy is below the configured thresholds.
+ * The counters are shared by the state and its clones, as SaStats are. States created by separate saInit() calls
+ * count separately.
+ * Tasks disabled by the task mask (SaConfig.scl_task_mask or saRunSclMasked()) are neither computed nor skipped by
+ * the cascade, they are not counted and their result stays empty. If the occupied task of a position is disabled,
+ * the position is gated by its quality only and is never counted in skipped_unoccupied.
+ * \see saGetCascadeStats */
+typedef struct
+{
+    unsigned long long positions;           /**< Number of classified seat positions */
+    unsigned long long skipped_low_quality; /**< Positions skipped due to SaPosition.quality below SaConfig.scl_cascade_min_quality */
+    unsigned long long skipped_unoccupied;  /**< Positions skipped as not occupied with enough confidence */
+    unsigned long long driver_computed;     /**< Number of computed driver tasks */
+    unsigned long long driver_skipped;      /**< Number of skipped driver tasks */
+    unsigned long long belt_computed;       /**< Number of computed belt tasks */
+    unsigned long long belt_skipped;        /**< Number of skipped belt tasks */
+    unsigned long long phone_computed;      /**< Number of computed phone tasks */
+    unsigned long long phone_skipped;       /**< Number of skipped phone tasks */
+} SaCascadeStats;
+
+/** Video stream configuration structure
+ *
+ * Zero values select the default behavior.
+ * \see saStreamCreate */
+typedef struct
+{
+    int   redetect_interval;  /**< Full-frame detection is run every redetect_interval-th frame, detection in the predicted RoIs otherwise */
+    float roi_margin;         /**< Margin added around the predicted windshield position, relative to its size */
+    float min_overlap;        /**< Minimal intersection over union of a detection and a predicted track position to continue the track */
+    int   max_missed_frames;  /**< Number of consecutive frames without a matching detection after which the track is finished */
+    int   disable_scl;        /**< Non-zero to disable classification of the finished tracks */
+
+    // scene change gate for static cameras
+    int   change_gate;                  /**< Non-zero to skip detection on frames without a scene change while there is no active track */
+    float change_gate_threshold;        /**< Mean absolute difference of the downsampled luma against the background model [0-255] needed to run detection */
+    int   change_gate_downscale;        /**< Downscale factor of the luma compared by the gate */
+    float change_gate_learning_rate;    /**< Update rate of the background model (0-1], the background is blended with every frame while no track is active */
+    int   change_gate_refresh_interval; /**< Number of consecutive processed frames without a track after which the background is replaced by the current frame, 0 disables the refresh */
+} SaStreamConfig;
+
+/** Windshield track of a video stream.
+ * \see SaStreamResult */
+typedef struct
+{
+    int                 track_id;   /**< Unique identifier of the track within the stream */
+    SaDetection         detection;  /**< Last detection of the track */
+    int                 num_frames; /**< Number of frames the track has been detected in */
+    int                 finished;   /**< Non-zero if the track has been finished by this frame, it is not reported anymore */
+    int                 has_scl;    /**< Non-zero if scl_result is set, only finished tracks are classified */
+    SaSclResult         scl_result; /**< Seats classification from the best-quality frame of the track */
+    unsigned long long  best_frame; /**< Index of the frame the classification was computed from */
+} SaTrack;
+
+/** Result of one frame of a video stream.
+ * The tracks array is dynamically allocated and must be released by the saFreeStreamResult function.
+ * \see saStreamProcess, saStreamFlush */
+typedef struct
+{
+    unsigned long long  frame_index;    /**< Index of the frame in the stream, starting from zero */
+    int                 full_detection; /**< Non-zero if full-frame detection was run on this frame */
+    int                 gated;          /**< Non-zero if detection was skipped by the scene change gate */
+    int                 num_tracks;     /**< Number of tracks */
+    SaTrack            *tracks;         /**< Active tracks and tracks finished by this frame */
+} SaStreamResult;
+
+/** Counters of a video stream.
+ * \see saStreamGetStats */
+typedef struct
+{
+    unsigned long long  frames;          /**< Number of processed frames */
+    unsigned long long  full_detections; /**< Number of full-frame detections */
+    unsigned long long  roi_detections;  /**< Number of detections in predicted RoIs */
+    unsigned long long  tracks;          /**< Number of created tracks */
+    unsigned long long  scl_runs;        /**< Number of classifications */
+    unsigned long long  gated_frames;    /**< Number of frames skipped by the scene change gate, \see SaStreamConfig.change_gate */
+} SaStreamStats;
+
+/** Numeric detection label
+ *
+ * Index of the label in the label set of the loaded detector, negative value signifies an unknown label.
+ * The ids are not fixed constants, they depend on the detector model and are valid only until the next saReloadModels()
+ * of the state or its clones. Query them by saGetLabelId() after every reload instead of caching them.
+ * \see saGetLabelName, saGetLabelId, SaCompactDetection */
+typedef int SaLabelId;
+
+/** \defgroup SA_CLASS_RESULTS Compact classification results
+ * @{ Values of SaCompactClass.result, counterparts of SaClass.result characters. */
+#define SA_CLASS_FALSE      0  /**< '0' - "false" */
+#define SA_CLASS_TRUE       1  /**< '1' - "true" */
+#define SA_CLASS_UNKNOWN   -1  /**< '?' - neither "true" or "false" can be determined with large enough confidence */
+#define SA_CLASS_UNDEFINED -2  /**< empty string - the task is not implemented for the position */
+/** @} */
+
+/** Compact counterpart of SaDetection.
+ * \see saRunDetCompact */
+typedef struct
+{
+    ERRotatedRect       position;   /**< Object position */
+    float               confidence; /**< Detection confidence factor */
+    SaLabelId           label_id;   /**< Detection type label, \see saGetLabelName */
+} SaCompactDetection;
+
+/** Compact counterpart of SaClass.
+ * \see SaCompactPosition */
+typedef struct
+{
+    float       confidences[NUM_CONF_OUTPUTS]; /**< Confidence for each possible output - False, True, Neither */
+    float       confidence; /**< Confidence of the result */
+    int8_t      result;     /**< One of SA_CLASS_FALSE, SA_CLASS_TRUE, SA_CLASS_UNKNOWN or SA_CLASS_UNDEFINED */
+} SaCompactClass;
+
+/** Compact counterpart of SaPosition, fits into two cache lines.
+ * \see SaCompactSclResult */
+typedef struct
+{
+    float           quality;  /**< General image "quality" at the given position */
+    SaCompactClass  occupied; /**< Is the seat occupied by a passenger? */
+    SaCompactClass  driver;   /**< Is the driver on this seat on this seat position? */
+    SaCompactClass  belt;     /**< Does the passenger on this seatbelt have their seatbelt fastened? */
+    SaCompactClass  phone;    /**< Is the passenger on this position holding a mobile phone? */
+} SaCompactPosition;
+
+/** Compact counterpart of SaSclResult.
+ * Holds the same information as SaSclResult in less than a tenth of its size, the same tasks are implemented.
+ * \see saRunSclCompact */
+typedef struct
+{
+    SaCompactPosition  left;   /**< Left position in the vehicle from the perspective of the camera. */
+    SaCompactPosition  middle; /**< Middle position in the vehicle from the perspective of the camera. */
+    SaCompactPosition  right;  /**< Right position in the vehicle from the perspective of the camera. */
+} SaCompactSclResult;
+
+/** Identifier of an asynchronous task
+ * \see saSubmitDet, saSubmitScl, saPoll, saWait */
+typedef unsigned long long SaTicket;
+
+/** Type of an asynchronous task
+ * \see SaTaskResult */
+typedef enum
+{
+    SA_TASK_DET = 0, /**< Windshield detection, \see saSubmitDet */
+    SA_TASK_SCL = 1  /**< Seats classification, \see saSubmitScl */
+} SaTaskType;
+
+/** Result of an asynchronous task.
+ * Only the result corresponding to task_type is set. The det_result of a successful SA_TASK_DET task
+ * must be released by the saFreeDetResult function.
+ * \see saPoll, saWait, fcn_saCompletionCallback */
+typedef struct
+{
+    SaTicket            ticket;     /**< Ticket returned by the submit function */
+    SaTaskType          task_type;  /**< Type of the task */
+    int                 status;     /**< Zero if the task succeeded, error code otherwise */
+    SaDetResult         det_result; /**< Detection result, set for SA_TASK_DET */
+    SaSclResult         scl_result; /**< Classification result, set for SA_TASK_SCL */
+} SaTaskResult;
+
+/** Completion callback of an asynchronous task
+ *  Called from a worker thread as soon as the task is finished. The result is valid only during the call,
+ *  the ownership of result->det_result is passed to the callback, i.e. it has to be released by saFreeDetResult.
+ *  The callback should return quickly as it occupies the worker thread.
+ *  \see saSubmitDet, saSubmitScl */
+typedef void (*fcn_saCompletionCallback) (const SaTaskResult *result, void *user_data);
 /** @} */
 
 
@@ -170,10 +511,41 @@ typedef struct
  * @{ Function pointer type definitions used when using explicit linking. */
 typedef const char*  (*fcn_saVersion)();
 typedef int  (*fcn_saInit)(const char *, SaConfig* const, SAState *);
+typedef int  (*fcn_saCloneState)(SAState, SAState *);
+typedef int  (*fcn_saGetInitTiming)(SAState, SaInitTiming *);
+typedef int  (*fcn_saReloadModels)(SAState, const char *, const SaConfig *);
 typedef void (*fcn_saFree)(SAState);
 typedef int  (*fcn_saRunDet)(SAState, const ERImage, const ERRoI *, SaDetResult *);
+typedef int  (*fcn_saRunDetBatch)(SAState, const ERImage *, const ERRoI * const *, int, SaDetResult *);
+typedef int  (*fcn_saRunDetInto)(SAState, const ERImage, const ERRoI *, SaDetection *, int, int *);
 typedef void (*fcn_saFreeDetResult)(SAState, SaDetResult *);
 typedef int  (*fcn_saRunScl)(SAState, const ERImage, const ERRotatedRect *, const SaDetectionLabel, SaSclResult *);
+typedef int  (*fcn_saRunSclMasked)(SAState, const ERImage, const ERRotatedRect *, const SaDetectionLabel, unsigned int, SaSclResult *);
+typedef int  (*fcn_saRunSclBatch)(SAState, const ERImage *, int, const int *, const ERRotatedRect *, const SaDetectionLabel *, int, SaSclResult *);
+typedef int  (*fcn_saRunDetScl)(SAState, const ERImage, const ERRoI *, SaFullResult *);
+typedef int  (*fcn_saRunDetSclDual)(SAState, const ERImage, const ERImage, const SaScaleMapping *, const ERRoI *, SaFullResult *);
+typedef void (*fcn_saFreeFullResult)(SAState, SaFullResult *);
+typedef int  (*fcn_saMapRotatedRect)(const SaScaleMapping *, const ERRotatedRect *, int, ERRotatedRect *);
+typedef int  (*fcn_saGetStats)(SAState, SaStats *);
+typedef void (*fcn_saResetStats)(SAState);
+typedef int  (*fcn_saTraceStart)(SAState, unsigned int);
+typedef int  (*fcn_saTraceStop)(SAState, const char *);
+typedef int  (*fcn_saGetCascadeStats)(SAState, SaCascadeStats *);
+typedef void (*fcn_saResetCascadeStats)(SAState);
+typedef int  (*fcn_saRunDetCompact)(SAState, const ERImage, const ERRoI *, SaCompactDetection *, int, int *);
+typedef int  (*fcn_saRunSclCompact)(SAState, const ERImage, const ERRotatedRect *, SaLabelId, SaCompactSclResult *);
+typedef const char* (*fcn_saGetLabelName)(SAState, SaLabelId);
+typedef SaLabelId (*fcn_saGetLabelId)(SAState, const char *);
+typedef int  (*fcn_saStreamCreate)(SAState, const SaStreamConfig *, SAStream *);
+typedef void (*fcn_saStreamFree)(SAStream);
+typedef int  (*fcn_saStreamProcess)(SAStream, const ERImage, SaStreamResult *);
+typedef int  (*fcn_saStreamFlush)(SAStream, SaStreamResult *);
+typedef void (*fcn_saFreeStreamResult)(SAStream, SaStreamResult *);
+typedef int  (*fcn_saStreamGetStats)(SAStream, SaStreamStats *);
+typedef int  (*fcn_saSubmitDet)(SAState, const ERImage, const ERRoI *, fcn_saCompletionCallback, void *, SaTicket *);
+typedef int  (*fcn_saSubmitScl)(SAState, const ERImage, const ERRotatedRect *, const SaDetectionLabel, fcn_saCompletionCallback, void *, SaTicket *);
+typedef int  (*fcn_saPoll)(SAState, SaTicket, SaTaskResult *);
+typedef int  (*fcn_saWait)(SAState, SaTicket, int, SaTaskResult *);
 /** @} */
 
 /** \addtogroup ExplicitLinking
@@ -200,6 +572,40 @@ typedef struct
     fcn_erImageRead                     erImageRead;                      /**< erImageRead */
     fcn_erImageWrite                    erImageWrite;                     /**< erImageWrite */
     fcn_erImageFree                     erImageFree;                      /**< erImageFree */
+    /* Functions added after the initial release. Members are only ever
+     * appended here so that the layout above stays binary compatible. */
+    fcn_saRunDetBatch                   saRunDetBatch;                    /**< saRunDetBatch */
+    fcn_saRunSclBatch                   saRunSclBatch;                    /**< saRunSclBatch */
+    fcn_saRunDetScl                     saRunDetScl;                      /**< saRunDetScl */
+    fcn_saFreeFullResult                saFreeFullResult;                 /**< saFreeFullResult */
+    fcn_saCloneState                    saCloneState;                     /**< saCloneState */
+    fcn_saSubmitDet                     saSubmitDet;                      /**< saSubmitDet */
+    fcn_saSubmitScl                     saSubmitScl;                      /**< saSubmitScl */
+    fcn_saPoll                          saPoll;                           /**< saPoll */
+    fcn_saWait                          saWait;                           /**< saWait */
+    fcn_saRunDetInto                    saRunDetInto;                     /**< saRunDetInto */
+    fcn_saRunDetCompact                 saRunDetCompact;                  /**< saRunDetCompact */
+    fcn_saRunSclCompact                 saRunSclCompact;                  /**< saRunSclCompact */
+    fcn_saGetLabelName                  saGetLabelName;                   /**< saGetLabelName */
+    fcn_saGetLabelId                    saGetLabelId;                     /**< saGetLabelId */
+    fcn_saRunSclMasked                  saRunSclMasked;                   /**< saRunSclMasked */
+    fcn_saGetCascadeStats               saGetCascadeStats;                /**< saGetCascadeStats */
+    fcn_saResetCascadeStats             saResetCascadeStats;              /**< saResetCascadeStats */
+    fcn_saStreamCreate                  saStreamCreate;                   /**< saStreamCreate */
+    fcn_saStreamFree                    saStreamFree;                     /**< saStreamFree */
+    fcn_saStreamProcess                 saStreamProcess;                  /**< saStreamProcess */
+    fcn_saStreamFlush                   saStreamFlush;                    /**< saStreamFlush */
+    fcn_saFreeStreamResult              saFreeStreamResult;               /**< saFreeStreamResult */
+    fcn_saStreamGetStats                saStreamGetStats;                 /**< saStreamGetStats */
+    fcn_saGetInitTiming                 saGetInitTiming;                  /**< saGetInitTiming */
+    fcn_saReloadModels                  saReloadModels;                   /**< saReloadModels */
+    fcn_saGetStats                      saGetStats;                       /**< saGetStats */
+    fcn_saResetStats                    saResetStats;                     /**< saResetStats */
+    fcn_saTraceStart                    saTraceStart;                     /**< saTraceStart */
+    fcn_saTraceStop                     saTraceStop;                      /**< saTraceStop */
+    fcn_saRunDetSclDual                 saRunDetSclDual;                  /**< saRunDetSclDual */
+    fcn_saMapRotatedRect                saMapRotatedRect;                 /**< saMapRotatedRect */
+    fcn_erImageReadFromMemory           erImageReadFromMemory;            /**< erImageReadFromMemory */
 } SaAPI;
 /** @} */
 
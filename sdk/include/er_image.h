@@ -17,6 +17,7 @@
 #define EYEDEA_ER_IMAGE_H
 
 #include "er_explink.h"
+#include <stddef.h>
 
 /* ***************************************************************************
  * IMAGE COLOR MODELS                                                        *
@@ -32,7 +33,9 @@ typedef enum {
     ER_IMAGE_COLORMODEL_BGR       = 2,   /* Color image BGR channels */
     ER_IMAGE_COLORMODEL_YCBCR420  = 3,   /* YCbCr 4:2:0 image */
     ER_IMAGE_COLORMODEL_BGRA      = 4,   /* Color image BGRA channels */
-    ER_IMAGE_COLORMODEL_YCBCRNV12 = 5    /* YCbCr with NV12 layout image */
+    ER_IMAGE_COLORMODEL_YCBCRNV12 = 5,   /* YCbCr with NV12 layout image */
+    ER_IMAGE_COLORMODEL_RGB       = 6,   /* Color image RGB channels */
+    ER_IMAGE_COLORMODEL_RGBA      = 7    /* Color image RGBA channels */
 } ERImageColorModel;
 
 /* ***************************************************************************
@@ -40,8 +43,10 @@ typedef enum {
  * Image data type per channel.                                              *
  * Eg. ER_IMAGE_COLORMODEL_BGR image with ER_IMAGE_DATATYPE_UCHAR takes      *
  * 3 bytes per pixel.                                                        *
- * NOTE: ER_IMAGE_COLORMODEL_YCBCR420 and ER_IMAGE_COLORMODEL_YCBCRNV12      *
- * color models are supported as an crop image input only.                   *
+ * NOTE: ER_IMAGE_COLORMODEL_YCBCR420 (I420 layout - Y plane, Cb plane and  *
+ * Cr plane) and ER_IMAGE_COLORMODEL_YCBCRNV12 (Y plane and interleaved CbCr *
+ * plane) color models are supported with ER_IMAGE_DATATYPE_UCHAR only.      *
+ * Width and height of YCbCr images have to be even.                         *
  * ***************************************************************************/
 typedef enum {
     ER_IMAGE_DATATYPE_UNK   = 0,        /* Unknown data type */
@@ -71,6 +76,17 @@ typedef struct
     unsigned char     data_allocated;   /*!< flag if structure use self allocated data */
 } ERImage;
 
+/* ***************************************************************************
+ * IMAGE READ FLAGS                                                          *
+ * Flags of erImageReadFromMemory.                                           *
+ * ER_IMAGE_READ_REUSE - the image is decoded into the data of the given     *
+ * ERImage filled by a previous read, erImageAllocate or                     *
+ * erImageAllocateAndWrap. Self allocated data are reallocated only if too   *
+ * small, so a pooled ERImage needs no allocation per frame. Decoding into   *
+ * a wrapped caller's buffer fails if the buffer is too small.               *
+ * ***************************************************************************/
+#define ER_IMAGE_READ_REUSE 0x1
+
 
 /* ***************************************************************************
  * HELPER FUNCTIONS FOR ERImage                                              *
@@ -100,6 +116,11 @@ ER_FUNCTION_PREFIX int          erImageCopy(const ERImage* image, ERImage* image
 /** Read image from file */
 ER_FUNCTION_PREFIX int          erImageRead(ERImage* image, const char *filename);
 
+/** Read image from encoded data in memory (JPEG, PNG, BMP). JPEG images are decoded downscaled in DCT domain if scale_denom is 2, 4 or 8,
+ *  other formats are decoded in full resolution and resized. The decoded image is ceil(width / scale_denom) x ceil(height / scale_denom), scale_denom 1 for full resolution.
+ *  \see ER_IMAGE_READ_REUSE */
+ER_FUNCTION_PREFIX int          erImageReadFromMemory(ERImage* image, const unsigned char* data, size_t data_size, unsigned int scale_denom, unsigned int flags);
+
 /** Write image to file */
 ER_FUNCTION_PREFIX int          erImageWrite(const ERImage* image, const char* filename);
 
@@ -124,6 +145,7 @@ typedef int          (*fcn_erImageAllocate)                 (ERImage*, unsigned
 typedef int          (*fcn_erImageAllocateAndWrap)          (ERImage*, unsigned int, unsigned int, ERImageColorModel, ERImageDataType, unsigned char*, unsigned int);
 typedef int          (*fcn_erImageCopy)                     (const ERImage*, ERImage*);
 typedef int          (*fcn_erImageRead)                     (ERImage*, const char*);
+typedef int          (*fcn_erImageReadFromMemory)           (ERImage*, const unsigned char*, size_t, unsigned int, unsigned int);
 typedef int          (*fcn_erImageWrite)                    (const ERImage*, const char*);
 typedef void         (*fcn_erImageFree)                     (ERImage*);
 typedef const char*  (*fcn_erVersion)                       (void);
@@ -0,0 +1,100 @@
+"""
+Benchmark script comparing Python overhead of the object and numpy result variants:
+run_det vs run_det_np and run_scl vs run_scl_np on images in IMAGES_PATH,
+then throughput of run_det_np driven by several Python threads, each with its own clone.
+"""
+
+import os
+import time
+import threading
+from cffi import FFI
+from PIL import Image
+
+from seatsanalyzer import Seatsanalyzer
+from er import ER, ERRotatedRect
+
+# PATHS
+EXAMPLES_DIR = os.path.dirname(os.path.realpath(__file__))
+PACKAGE_DIR = os.path.join(EXAMPLES_DIR, "..", "..")
+SDK_DIR = os.path.join(PACKAGE_DIR, "sdk")
+LIB_DIR = os.path.join(SDK_DIR, "lib")
+IMAGES_PATH = os.path.join(PACKAGE_DIR, "data", "images")
+
+NUM_ROUNDS = 10
+
+# setup paths lib and config
+lib_name = [name for name in os.listdir(LIB_DIR) if name.startswith("libseatsanalyzer")][0]
+SEATSANALYZER_LIB_PATH = os.path.join(LIB_DIR, lib_name)
+CONFIG_PATH = os.path.join(SDK_DIR, "config.ini")
+
+
+def measure(name, function, args_list):
+    """Calls function with each of args_list NUM_ROUNDS times and prints the mean wall time per call."""
+    t = time.perf_counter()
+    for _ in range(NUM_ROUNDS):
+        for args in args_list:
+            function(*args)
+    duration = time.perf_counter() - t
+    num_calls = NUM_ROUNDS * len(args_list)
+    print("{:<12} {:6d} calls, {:.3f} ms/call".format(name, num_calls, duration / num_calls * 1000.))
+    return duration / num_calls
+
+
+# init library
+ffi = FFI()
+eyedea_er = ER(ffi, SEATSANALYZER_LIB_PATH)
+sa = Seatsanalyzer(ffi, SEATSANALYZER_LIB_PATH)
+sa.init(CONFIG_PATH, None)
+
+images = []
+for file in sorted(os.listdir(IMAGES_PATH)):
+    img = Image.open(os.path.join(IMAGES_PATH, file)).convert("RGB")
+    images.append(eyedea_er.wrap_pil_image(img))
+
+# windshield crops for the classification
+window_id = sa.get_label_id("window")
+crops = []
+for image in images:
+    detections = sa.run_det_np(image)
+    for detection in detections[detections["label_id"] == window_id]:
+        crops.append((image, detection["position"]))
+
+print("Detection, {} images:".format(len(images)))
+det_object = measure("run_det", sa.run_det, [(image,) for image in images])
+det_np = measure("run_det_np", sa.run_det_np, [(image,) for image in images])
+print("Saved {:.3f} ms/call".format((det_object - det_np) * 1000.))
+
+if len(crops) > 0:
+    print("Classification, {} crops:".format(len(crops)))
+    rects = []
+    for _, position in crops:
+        rect = ERRotatedRect()
+        rect.x, rect.y, rect.width, rect.height, rect.angle = [float(value) for value in position]
+        rects.append(rect)
+    scl_object = measure("run_scl", sa.run_scl,
+                         [(image, rect, "window") for (image, _), rect in zip(crops, rects)])
+    scl_np = measure("run_scl_np", sa.run_scl_np,
+                     [(image, position, window_id) for image, position in crops])
+    print("Saved {:.3f} ms/call".format((scl_object - scl_np) * 1000.))
+
+# several Python threads, the C calls run with the GIL released
+print("Threads, run_det_np:")
+max_threads = os.cpu_count() or 1
+num_threads = 1
+while num_threads <= max_threads:
+    clones = [sa] + [sa.clone() for _ in range(num_threads - 1)]
+
+    def worker(clone):
+        for _ in range(NUM_ROUNDS):
+            for image in images:
+                clone.run_det_np(image)
+
+    threads = [threading.Thread(target=worker, args=(clone,)) for clone in clones]
+    t = time.perf_counter()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    duration = time.perf_counter() - t
+    print("{:3d} threads: {:.1f} frames/s".format(num_threads, num_threads * NUM_ROUNDS * len(images) / duration))
+    num_threads *= 2
@@ -0,0 +1,68 @@
+"""
+Benchmark script comparing throughput of the serial loop with SeatsanalyzerPool:
+detection on all images in IMAGES_PATH by a single Seatsanalyzer, by a pool of worker threads
+and by a pool of worker processes with the shared-memory ring.
+"""
+
+import os
+import time
+import multiprocessing
+import numpy as np
+from cffi import FFI
+from PIL import Image
+
+from seatsanalyzer import Seatsanalyzer
+from seatsanalyzer_pool import SeatsanalyzerPool
+from er import ER
+
+# PATHS
+EXAMPLES_DIR = os.path.dirname(os.path.realpath(__file__))
+PACKAGE_DIR = os.path.join(EXAMPLES_DIR, "..", "..")
+SDK_DIR = os.path.join(PACKAGE_DIR, "sdk")
+LIB_DIR = os.path.join(SDK_DIR, "lib")
+IMAGES_PATH = os.path.join(PACKAGE_DIR, "data", "images")
+
+NUM_ROUNDS = 10
+
+# setup paths lib and config
+lib_name = [name for name in os.listdir(LIB_DIR) if name.startswith("libseatsanalyzer")][0]
+SEATSANALYZER_LIB_PATH = os.path.join(LIB_DIR, lib_name)
+CONFIG_PATH = os.path.join(SDK_DIR, "config.ini")
+
+
+def print_speed(name, num_frames, duration):
+    print("{:<24} {:6d} frames, {:8.1f} frames/s".format(name, num_frames, num_frames / duration))
+
+
+if __name__ == "__main__":
+    frames = [np.asarray(Image.open(os.path.join(IMAGES_PATH, file)).convert("RGB"))
+              for file in sorted(os.listdir(IMAGES_PATH))]
+    all_frames = frames * NUM_ROUNDS
+    max_frame_bytes = max(frame.nbytes for frame in frames)
+    num_workers = multiprocessing.cpu_count() or 1
+
+    # serial loop
+    ffi = FFI()
+    eyedea_er = ER(ffi, SEATSANALYZER_LIB_PATH)
+    sa = Seatsanalyzer(ffi, SEATSANALYZER_LIB_PATH)
+    sa.init(CONFIG_PATH, None)
+    t = time.perf_counter()
+    for frame in all_frames:
+        sa.run_det_np(eyedea_er.wrap_nparray(frame, "RGB"))
+    serial_duration = time.perf_counter() - t
+    print_speed("serial", len(all_frames), serial_duration)
+
+    for use_processes in [False, True]:
+        name = "{} {}".format(num_workers, "processes" if use_processes else "threads")
+        with SeatsanalyzerPool(SEATSANALYZER_LIB_PATH, CONFIG_PATH, num_workers=num_workers,
+                               use_processes=use_processes, max_frame_bytes=max_frame_bytes) as pool:
+            # warm-up, one frame per worker
+            for _ in pool.run_det_many(frames[:1] * num_workers):
+                pass
+            for ordered in [True, False]:
+                t = time.perf_counter()
+                for _ in pool.run_det_many(all_frames, "RGB", ordered=ordered):
+                    pass
+                duration = time.perf_counter() - t
+                print_speed(name + (" ordered" if ordered else " unordered"), len(all_frames), duration)
+                print("{:<24} speed-up {:.2f}x".format("", serial_duration / duration))
@@ -19,6 +19,7 @@ from cffi import FFI
 from PIL import Image
 import numpy as np
 import inspect
+import weakref
 
 ER_IMAGE_COLORMODEL_UNK = 0
 ER_IMAGE_COLORMODEL_GRAY = 1
@@ -26,13 +27,31 @@ ER_IMAGE_COLORMODEL_BGR = 2
 ER_IMAGE_COLORMODEL_YCBCR420 = 3
 ER_IMAGE_COLORMODEL_BGRA = 4
 ER_IMAGE_COLORMODEL_YCBCRNV12 = 5
+ER_IMAGE_COLORMODEL_RGB = 6
+ER_IMAGE_COLORMODEL_RGBA = 7
 
 ER_IMAGE_ALL_COLORMODELS = [ER_IMAGE_COLORMODEL_UNK,
                             ER_IMAGE_COLORMODEL_GRAY,
                             ER_IMAGE_COLORMODEL_BGR,
                             ER_IMAGE_COLORMODEL_YCBCR420,
                             ER_IMAGE_COLORMODEL_BGRA,
-                            ER_IMAGE_COLORMODEL_YCBCRNV12]
+                            ER_IMAGE_COLORMODEL_YCBCRNV12,
+                            ER_IMAGE_COLORMODEL_RGB,
+                            ER_IMAGE_COLORMODEL_RGBA]
+
+# numpy image modes and corresponding color models
+NP_IMAGE_MODES = {"L": ER_IMAGE_COLORMODEL_GRAY,
+                  "BGR": ER_IMAGE_COLORMODEL_BGR,
+                  "BGRA": ER_IMAGE_COLORMODEL_BGRA,
+                  "RGB": ER_IMAGE_COLORMODEL_RGB,
+                  "RGBA": ER_IMAGE_COLORMODEL_RGBA,
+                  "I420": ER_IMAGE_COLORMODEL_YCBCR420,
+                  "NV12": ER_IMAGE_COLORMODEL_YCBCRNV12}
+
+# wrapped ERImage -> owner of its data, keeps the owner alive as long as the ERImage exists
+wrapped_owners = weakref.WeakKeyDictionary()
+
+ER_IMAGE_READ_REUSE = 0x1
 
 ER_IMAGE_DATATYPE_UNK = 0
 ER_IMAGE_DATATYPE_UCHAR = 1
@@ -161,7 +180,9 @@ class ER:
                      ER_IMAGE_COLORMODEL_BGR      = 2,
                      ER_IMAGE_COLORMODEL_YCBCR420 = 3,
                      ER_IMAGE_COLORMODEL_BGRA     = 4,
-                     ER_IMAGE_COLORMODEL_YCBCRNV12 = 5
+                     ER_IMAGE_COLORMODEL_YCBCRNV12 = 5,
+                     ER_IMAGE_COLORMODEL_RGB      = 6,
+                     ER_IMAGE_COLORMODEL_RGBA     = 7
                  } ERImageColorModel;
                  """)
 
@@ -246,6 +267,21 @@ class ER:
                                               ERImageColorModel color_model, ERImageDataType data_type);
                  """)
 
+        ffi.cdef("""
+                 int          erImageAllocateAndWrap(ERImage* image, unsigned int width, unsigned int height,
+                                                     ERImageColorModel color_model, ERImageDataType data_type,
+                                                     unsigned char* data, unsigned int step);
+                 """)
+
+        ffi.cdef("""
+                 int          erImageCopy(const ERImage* image, ERImage* image_copy);
+                 """)
+
+        ffi.cdef("""
+                 int          erImageReadFromMemory(ERImage* image, const unsigned char* data, size_t data_size,
+                                                    unsigned int scale_denom, unsigned int flags);
+                 """)
+
         ffi.cdef("""
                  void         erImageFree(ERImage *image);
                  """)
@@ -271,49 +307,47 @@ class ER:
                           -1)
 
     def convert_pil_image_to_erimage(self, pil_image):
-        # check that one of base classes is PIL.Image.Image
-        if Image.Image not in inspect.getmro(pil_image.__class__):
-            raise TypeError("Input pil_image must be a PIL.Image.Image object.")
-
-        if FFI not in inspect.getmro(self.ffi.__class__):
-            raise TypeError("Input must be a FFI class from cffi.")
-
-        width = self.ffi.cast("unsigned int", pil_image.width)
-        height = self.ffi.cast("unsigned int", pil_image.height)
-
-        # expect uchar data type
-        data_type = ER_IMAGE_DATATYPE_UCHAR
+        """
+        Converts PIL image of mode L, RGB or RGBA into ERImage of color model GRAY, BGR or BGRA respectively.
+        The pixel data are copied once, reordering the channels on the way. Use wrap_pil_image to pass the image
+        to SDK in its RGB or RGBA order without the copy.
+        :param pil_image: Input PIL image.
+        :return: ERImage owning a copy of the pixel data.
+        """
+        self.__check_pil_image(pil_image)
 
+        np_image = np.asarray(pil_image)
         if pil_image.mode == "L":
-            color_model = ER_IMAGE_COLORMODEL_GRAY
+            return self.wrap_nparray(np.array(np_image), "L")
         elif pil_image.mode == "RGB":
-            color_model = ER_IMAGE_COLORMODEL_BGR
-            # convert to BGR
-            b, g, r = pil_image.split()
-            pil_image = Image.merge("RGB", (r, g, b))
-        elif pil_image.mode == "RGBA":
-            color_model = ER_IMAGE_COLORMODEL_BGRA
-            # convert to BGRA
-            b, g, r, a = pil_image.split()
-            pil_image = Image.merge("RGBA", (r, g, b, a))
+            # fancy indexing returns a contiguous copy in BGR order
+            return self.wrap_nparray(np_image[:, :, [2, 1, 0]], "BGR")
         else:
-            print("Color model conversion not implemented")
-            raise TypeError("Input pil_image object must be of mode L or RGB.")
-
-        er_image = self.ffi.new("ERImage*")
+            return self.wrap_nparray(np_image[:, :, [2, 1, 0, 3]], "BGRA")
 
-        ret_val = self.__er.erImageAllocate(er_image, width, height, color_model, data_type)
+    def wrap_pil_image(self, pil_image):
+        """
+        Wraps PIL image of mode L, RGB or RGBA into ERImage of color model GRAY, RGB or RGBA respectively.
+        The pixel data are exported by PIL once and wrapped without further copies, the channel order is handled by SDK.
+        Unlike convert_pil_image_to_erimage, the result is not BGR, use it only with functions accepting RGB input.
+        :param pil_image: Input PIL image.
+        :return: ERImage, the exported pixel data are kept alive as long as the ERImage exists.
+        """
+        self.__check_pil_image(pil_image)
 
-        if ret_val != 0:
-            raise TypeError("Failed to allocate ERImage.")
+        return self.wrap_nparray(np.asarray(pil_image), pil_image.mode)
 
-        # copy data to er image
-        byte_buffer = pil_image.tobytes()
-        self.ffi.memmove(er_image.data, byte_buffer, er_image.step * er_image.height)
+    def __check_pil_image(self, pil_image):
+        # check that one of base classes is PIL.Image.Image
+        if Image.Image not in inspect.getmro(pil_image.__class__):
+            raise TypeError("Input pil_image must be a PIL.Image.Image object.")
 
-        er_image_gc = self.ffi.gc(er_image, self.__er.erImageFree)
+        if FFI not in inspect.getmro(self.ffi.__class__):
+            raise TypeError("Input must be a FFI class from cffi.")
 
-        return er_image_gc
+        if pil_image.mode not in ["L", "RGB", "RGBA"]:
+            print("Color model conversion not implemented")
+            raise TypeError("Input pil_image object must be of mode L, RGB or RGBA.")
 
     @staticmethod
     def convert_erimage_to_nparray(er_image):
@@ -325,26 +359,34 @@ class ER:
         else:
             raise TypeError("Expected er_image.data_type either uchar or float.")
 
-        if er_image.color_model == ER_IMAGE_COLORMODEL_GRAY:
-            mode = "L"
-        elif er_image.color_model == ER_IMAGE_COLORMODEL_BGR:
-            mode = "BGR"
-        else:
-            raise TypeError("Expected er_image.color_model either GRAY or BGR.")
-
-        # check there is no step
-        if er_image.depth * er_image.width != er_image.step:
-            raise ValueError("Input image data not continuous - not implemented.")
-
-        b = bytearray(er_image.data_size)
-        FFI().memmove(b, er_image.data, er_image.data_size)
-        np_image = np.frombuffer(b, np_dtype, er_image.height * er_image.width * er_image.num_channels)
+        modes = {ER_IMAGE_COLORMODEL_GRAY: "L",
+                 ER_IMAGE_COLORMODEL_BGR: "BGR",
+                 ER_IMAGE_COLORMODEL_BGRA: "BGRA",
+                 ER_IMAGE_COLORMODEL_RGB: "RGB",
+                 ER_IMAGE_COLORMODEL_RGBA: "RGBA"}
+        if er_image.color_model not in modes:
+            raise TypeError("Expected er_image.color_model GRAY, BGR, BGRA, RGB or RGBA.")
+        mode = modes[er_image.color_model]
+
+        # copy the rows, the possible alignment bytes at the end of each row are dropped
+        b = bytearray(er_image.step * er_image.height)
+        FFI().memmove(b, er_image.data, er_image.step * er_image.height)
+        np_image = np.frombuffer(b, "uint8").reshape([er_image.height, er_image.step])
+        np_image = np_image[:, :er_image.width * er_image.depth].view(np_dtype)
         np_image = np.reshape(np_image, [er_image.height, er_image.width, er_image.num_channels])
 
         return np_image, mode
 
-    def convert_nparray_to_erimage(self, np_image, np_image_mode):
-
+    def wrap_nparray(self, np_image, np_image_mode):
+        """
+        Wraps numpy array into ERImage without copying the data.
+        Any row stride is supported, the pixels of a row have to be packed. Other arrays (e.g. with negative strides or
+        a channel subset) are copied into a contiguous array first.
+        :param np_image: Array of shape (height, width) for mode L, (height, width, channels) for color modes or
+                         (height * 3 / 2, width) for modes I420 and NV12. Data type uint8 or float32.
+        :param np_image_mode: One of 'L', 'BGR', 'BGRA', 'RGB', 'RGBA', 'I420' or 'NV12'.
+        :return: ERImage referencing the array data, the array is kept alive as long as the ERImage exists.
+        """
         if np_image.dtype.type == np.uint8:
             data_type = ER_IMAGE_DATATYPE_UCHAR
         elif np_image.dtype.type == np.float32:
@@ -352,55 +394,122 @@ class ER:
         else:
             raise ValueError("np_image data type expected to be uint8 or float32.")
 
-        if np_image_mode == "L":
-            color_model = ER_IMAGE_COLORMODEL_GRAY
-        elif np_image_mode == "BGR":
-            color_model = ER_IMAGE_COLORMODEL_BGR
-        elif np_image_mode == "BGRA":
-            color_model = ER_IMAGE_COLORMODEL_BGRA
-        else:
-            raise ValueError("np_image_mode expected to be 'L', 'BGR' or 'BGRA'")
-
-        er_image = self.ffi.new("ERImage*")
+        if np_image_mode not in NP_IMAGE_MODES:
+            raise ValueError("np_image_mode expected to be 'L', 'BGR', 'BGRA', 'RGB', 'RGBA', 'I420' or 'NV12'")
+        color_model = NP_IMAGE_MODES[np_image_mode]
 
         width = np_image.shape[1]
         height = np_image.shape[0]
+        itemsize = np_image.dtype.itemsize
+
+        if color_model in [ER_IMAGE_COLORMODEL_YCBCR420, ER_IMAGE_COLORMODEL_YCBCRNV12]:
+            # 2D array with Y plane in full res followed by the chroma planes, 1.5 * height rows in total
+            if data_type != ER_IMAGE_DATATYPE_UCHAR or np_image.ndim != 2 or height % 3 != 0 or width % 2 != 0:
+                raise ValueError("YCbCr np_image expected to be uint8 array of shape (height * 3 / 2, width).")
+            height = height * 2 // 3
+            if height % 2 != 0:
+                raise ValueError("YCbCr image height must be even.")
+            # the chroma planes are addressed by the packed width
+            np_image = np.ascontiguousarray(np_image)
+        else:
+            num_channels = 1 if color_model == ER_IMAGE_COLORMODEL_GRAY else len(np_image_mode)
+            if np_image.ndim == 3 and np_image.shape[2] == num_channels:
+                pixel_strides_packed = np_image.strides[2] == itemsize and np_image.strides[1] == num_channels * itemsize
+            elif np_image.ndim == 2 and num_channels == 1:
+                pixel_strides_packed = np_image.strides[1] == itemsize
+            else:
+                raise ValueError("np_image shape does not correspond to mode '{}'.".format(np_image_mode))
+            if not pixel_strides_packed or np_image.strides[0] < width * num_channels * itemsize:
+                np_image = np.ascontiguousarray(np_image)
+
+        address = np_image.__array_interface__["data"][0]
 
-        ret_val = self.__er.erImageAllocate(er_image, width, height, color_model, data_type)
+        er_image = self.ffi.new("ERImage*")
+        ret_val = self.__er.erImageAllocateAndWrap(er_image, width, height, color_model, data_type,
+                                                   self.ffi.cast("unsigned char *", address), np_image.strides[0])
 
         if ret_val != 0:
-            raise TypeError("Failed to allocate ERImage.")
-
-        # copy data to er image
-        self.ffi.memmove(er_image.data, np_image.tobytes(), er_image.step * er_image.height)
+            raise TypeError("Failed to wrap ERImage.")
 
         er_image_gc = self.ffi.gc(er_image, self.__er.erImageFree)
+        wrapped_owners[er_image_gc] = np_image
 
         return er_image_gc
 
-    def convert_bytes_to_erimage(self, width, height, color_model, data_type, data, step):
-
+    def wrap_buffer(self, width, height, color_model, data_type, data, step):
+        """
+        Wraps an object supporting buffer protocol (bytes, bytearray, memoryview, mmap...) into ERImage without copying.
+        :param data: Contiguous buffer with rows of step bytes, for YCbCr color models followed by the chroma planes.
+        :param step: Byte size of a row including possible alignment bytes.
+        :return: ERImage referencing the buffer, the buffer is kept alive as long as the ERImage exists.
+        """
         if color_model not in ER_IMAGE_ALL_COLORMODELS or data_type not in ER_IMAGE_ALL_DATATYPES:
             raise ValueError("Color model or data type not valid.")
 
-        size_of_element = (1 if data_type == ER_IMAGE_DATATYPE_UCHAR else 4
-                           if data_type == ER_IMAGE_DATATYPE_FLOAT else 0)
+        c_buffer = self.ffi.from_buffer(data)
 
-        if step != width * size_of_element:
-            raise NotImplementedError("Step size must be same as width*sizeof(element) now.")
+        num_rows = height + height // 2 \
+            if color_model in [ER_IMAGE_COLORMODEL_YCBCR420, ER_IMAGE_COLORMODEL_YCBCRNV12] else height
+        if len(c_buffer) < step * num_rows:
+            raise ValueError("Buffer too small for the image of given size and step.")
 
         er_image = self.ffi.new("ERImage*")
-        ret_val = self.__er.erImageAllocate(er_image, width, height, color_model, data_type)
+        ret_val = self.__er.erImageAllocateAndWrap(er_image, width, height, color_model, data_type,
+                                                   self.ffi.cast("unsigned char *", c_buffer), step)
 
         if ret_val != 0:
-            raise TypeError("Failed to allocate ERImage.")
-
-        if color_model in [ER_IMAGE_COLORMODEL_GRAY, ER_IMAGE_COLORMODEL_BGR, ER_IMAGE_COLORMODEL_BGRA]:
-            self.ffi.memmove(er_image.data, data, er_image.step * er_image.height)
-        elif color_model in [ER_IMAGE_COLORMODEL_YCBCR420, ER_IMAGE_COLORMODEL_YCBCRNV12]:
-            # Y plane in full res, then Cb and Cr as 1 per 2x2 pixels
-            self.ffi.memmove(er_image.data, data, er_image.step * (er_image.height + er_image.height // 2))
+            raise TypeError("Failed to wrap ERImage.")
 
         er_image_gc = self.ffi.gc(er_image, self.__er.erImageFree)
+        wrapped_owners[er_image_gc] = (data, c_buffer)
 
         return er_image_gc
+
+    def read_from_memory(self, data, scale_denom: int = 1, er_image=None):
+        """
+        Decodes an encoded image (JPEG, PNG, BMP) from an object supporting buffer protocol, e.g. bytes received over network.
+        :param data: Encoded image data.
+        :param scale_denom: 1 for full resolution, 2, 4 or 8 to decode JPEG downscaled in DCT domain.
+        :param er_image: Optional ERImage to decode into, e.g. the result of a previous call or of wrap_nparray,
+                         its data are reused if large enough.
+        :return: Decoded ERImage, er_image if given.
+        """
+        if scale_denom not in [1, 2, 4, 8]:
+            raise ValueError("scale_denom expected to be 1, 2, 4 or 8.")
+
+        c_data = self.ffi.from_buffer(data)
+
+        if er_image is None:
+            er_image = self.ffi.gc(self.ffi.new("ERImage*"), self.__er.erImageFree)
+            flags = 0
+        else:
+            flags = ER_IMAGE_READ_REUSE
+
+        ret_val = self.__er.erImageReadFromMemory(er_image, self.ffi.cast("unsigned char *", c_data), len(c_data),
+                                                  scale_denom, flags)
+
+        if ret_val != 0:
+            raise ErError("erImageReadFromMemory", ret_val)
+
+        return er_image
+
+    def __copy_erimage(self, er_image):
+        er_image_copy = self.ffi.new("ERImage*")
+        ret_val = self.__er.erImageCopy(er_image, er_image_copy)
+
+        if ret_val != 0:
+            raise TypeError("Failed to copy ERImage.")
+
+        return self.ffi.gc(er_image_copy, self.__er.erImageFree)
+
+    def convert_nparray_to_erimage(self, np_image, np_image_mode):
+        """
+        Copies numpy array into a newly allocated ERImage, use wrap_nparray for conversion without copying.
+        """
+        return self.__copy_erimage(self.wrap_nparray(np_image, np_image_mode))
+
+    def convert_bytes_to_erimage(self, width, height, color_model, data_type, data, step):
+        """
+        Copies buffer into a newly allocated ERImage, use wrap_buffer for conversion without copying.
+        """
+        return self.__copy_erimage(self.wrap_buffer(width, height, color_model, data_type, data, step))
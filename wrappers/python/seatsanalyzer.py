@@ -1,4 +1,5 @@
 import weakref
+import numpy as np
 from cffi import FFI
 from typing import Optional
 from er import ERRoI, ERRotatedRect
@@ -14,6 +15,66 @@ class SaError(Exception):
         self.internal_error_code = internal_error_code
 
 
+# numpy counterparts of the compact result structures, see SaCompactDetection and SaCompactSclResult
+SA_COMPACT_DETECTION_DTYPE = np.dtype([("position", "<f4", (5,)),
+                                       ("confidence", "<f4"),
+                                       ("label_id", "<i4")], align=True)
+SA_COMPACT_CLASS_DTYPE = np.dtype([("confidences", "<f4", (3,)),
+                                   ("confidence", "<f4"),
+                                   ("result", "i1")], align=True)
+SA_COMPACT_POSITION_DTYPE = np.dtype([("quality", "<f4"),
+                                      ("occupied", SA_COMPACT_CLASS_DTYPE),
+                                      ("driver", SA_COMPACT_CLASS_DTYPE),
+                                      ("belt", SA_COMPACT_CLASS_DTYPE),
+                                      ("phone", SA_COMPACT_CLASS_DTYPE)], align=True)
+SA_SCL_POSITION_NAMES = ["left", "middle", "right"]
+
+SA_CLASS_FALSE = 0
+SA_CLASS_TRUE = 1
+SA_CLASS_UNKNOWN = -1
+SA_CLASS_UNDEFINED = -2
+
+SA_STAGE_NAMES = ["det_preprocess", "det_inference", "det_postprocess",
+                  "scl_crop", "scl_inference", "scl_p_table"]
+
+SA_MODEL_LOAD_HEAP = 0
+SA_MODEL_LOAD_MMAP = 1
+
+SA_CPU_DISPATCH_AUTO = 0
+SA_CPU_DISPATCH_SCALAR = 1
+SA_CPU_DISPATCH_SSE4 = 2
+SA_CPU_DISPATCH_AVX2 = 3
+
+SA_PRECISION_FP32 = 0
+SA_PRECISION_INT8 = 1
+
+SA_SCL_TASK_OCCUPIED = 0x1
+SA_SCL_TASK_DRIVER = 0x2
+SA_SCL_TASK_BELT = 0x4
+SA_SCL_TASK_PHONE = 0x8
+SA_SCL_TASK_ALL = 0xF
+
+
+def sa_scl_left(tasks: int) -> int:
+    """Classification task mask for the left position."""
+    return tasks << 0
+
+
+def sa_scl_middle(tasks: int) -> int:
+    """Classification task mask for the middle position."""
+    return tasks << 4
+
+
+def sa_scl_right(tasks: int) -> int:
+    """Classification task mask for the right position."""
+    return tasks << 8
+
+
+def sa_scl_all_positions(tasks: int) -> int:
+    """Classification task mask for all positions."""
+    return sa_scl_left(tasks) | sa_scl_middle(tasks) | sa_scl_right(tasks)
+
+
 class SaConfig:
     """Mirror of SaConfig structure."""
 
@@ -31,6 +92,26 @@ class SaConfig:
         self.gpu_device_id = 0
         self.num_threads = 0
 
+        # classification tasks, zero for all tasks
+        self.scl_task_mask = 0
+
+        # classification cascade, disabled by default
+        self.scl_cascade = 0
+        self.scl_cascade_min_quality = 0.0
+        self.scl_cascade_min_occupied_confidence = 0.0
+
+        # model loading mode, SA_MODEL_LOAD_HEAP or SA_MODEL_LOAD_MMAP
+        self.model_load_mode = SA_MODEL_LOAD_HEAP
+
+        # Chrome trace JSON written when the state is freed, None to disable tracing
+        self.trace_filename = None
+
+        # instruction set of the CPU image kernels, SA_CPU_DISPATCH_AUTO for runtime detection
+        self.cpu_dispatch = SA_CPU_DISPATCH_AUTO
+
+        # inference precision, SA_PRECISION_FP32 or SA_PRECISION_INT8 (CPU only)
+        self.precision = SA_PRECISION_FP32
+
     def get_c(self, ffi: FFI):
         """
         Converts this Python structure into a C structure.
@@ -54,6 +135,9 @@ class SaConfig:
         scl_model_p_table_filename = ffi.new("const char []", self.scl_model_p_table_filename.encode("utf-8")) \
             if self.scl_model_p_table_filename is not None else ffi.NULL
 
+        trace_filename = ffi.new("const char []", self.trace_filename.encode("utf-8")) \
+            if self.trace_filename is not None else ffi.NULL
+
         # store the created sub-fields in a dict to avoid GC
         global_weakkeydict[c_structure] = (
             det_sdk_directory,
@@ -63,6 +147,8 @@ class SaConfig:
             scl_model_directory,
             scl_model_filename,
             scl_model_p_table_filename,
+
+            trace_filename,
         )
 
         # paths
@@ -85,6 +171,29 @@ class SaConfig:
         c_structure.scl_inference_callback = ffi.NULL
         c_structure.scl_inference_output_buffer_size = 0
 
+        # layout version, the cdef has to match the header of the library
+        c_structure.struct_size = ffi.sizeof("SaConfig")
+
+        # classification tasks
+        c_structure.scl_task_mask = ffi.cast("unsigned int", self.scl_task_mask)
+
+        # classification cascade
+        c_structure.scl_cascade = ffi.cast("int", self.scl_cascade)
+        c_structure.scl_cascade_min_quality = self.scl_cascade_min_quality
+        c_structure.scl_cascade_min_occupied_confidence = self.scl_cascade_min_occupied_confidence
+
+        # model loading
+        c_structure.model_load_mode = ffi.cast("SaModelLoadMode", self.model_load_mode)
+
+        # tracing
+        c_structure.trace_filename = trace_filename
+
+        # image kernels
+        c_structure.cpu_dispatch = ffi.cast("SaCpuDispatch", self.cpu_dispatch)
+
+        # inference precision
+        c_structure.precision = ffi.cast("SaPrecision", self.precision)
+
         return c_structure
 
 
@@ -224,6 +333,238 @@ class SaSclResult:
         self.right.c_init(ffi, c_structure.right)
 
 
+class SaFullDetection:
+    """Mirror of SaFullDetection structure."""
+
+    def __init__(self):
+        self.detection = SaDetection()
+        self.scl_result = None
+
+    def c_init(self, ffi: FFI, c_structure):
+        """
+        Fills this mirror structure with given C structure data.
+        :param ffi: Instance of the FFI class.
+        :param c_structure: C structure data.
+        """
+        if c_structure == ffi.NULL:
+            return
+
+        self.detection.c_init(ffi, ffi.addressof(c_structure, "detection"))
+        if c_structure.has_scl:
+            self.scl_result = SaSclResult()
+            self.scl_result.c_init(ffi, ffi.addressof(c_structure, "scl_result"))
+
+
+class SaFullResult:
+    """Mirror of SaFullResult structure."""
+
+    def __init__(self):
+        self.num_detections = 0
+        self.detections = []
+
+    def c_init(self, ffi: FFI, c_structure):
+        """
+        Fills this mirror structure with given C structure data.
+        :param ffi: Instance of the FFI class.
+        :param c_structure: C structure data.
+        """
+        if c_structure == ffi.NULL:
+            return
+
+        self.num_detections = c_structure.num_detections
+        self.detections = []
+        for i in range(c_structure.num_detections):
+            detection = SaFullDetection()
+            detection.c_init(ffi, c_structure.detections + i)
+            self.detections.append(detection)
+
+
+class SaScaleMapping:
+    """Mirror of SaScaleMapping structure, maps detection image coordinates to classification image coordinates."""
+
+    def __init__(self, scale_x: float = 1.0, scale_y: float = 1.0, offset_x: float = 0.0, offset_y: float = 0.0):
+        self.scale_x = scale_x
+        self.scale_y = scale_y
+        self.offset_x = offset_x
+        self.offset_y = offset_y
+
+    def get_c(self, ffi: FFI):
+        """
+        Converts this Python structure into a C structure.
+        :param ffi: The FFI to use for creation of the C structure.
+        :return: The resulting C structure
+        """
+        c_structure = ffi.new("SaScaleMapping *")
+
+        c_structure.scale_x = self.scale_x
+        c_structure.scale_y = self.scale_y
+        c_structure.offset_x = self.offset_x
+        c_structure.offset_y = self.offset_y
+
+        return c_structure
+
+
+class SaStreamConfig:
+    """Mirror of SaStreamConfig structure, zero values select the default behavior."""
+
+    def __init__(self):
+        self.redetect_interval = 0
+        self.roi_margin = 0.0
+        self.min_overlap = 0.0
+        self.max_missed_frames = 0
+        self.disable_scl = 0
+
+        # scene change gate for static cameras, disabled by default
+        self.change_gate = 0
+        self.change_gate_threshold = 0.0
+        self.change_gate_downscale = 0
+        self.change_gate_learning_rate = 0.0
+        self.change_gate_refresh_interval = 0
+
+    def get_c(self, ffi: FFI):
+        """
+        Converts this Python structure into a C structure.
+        :param ffi: The FFI to use for creation of the C structure.
+        :return: The resulting C structure
+        """
+        c_structure = ffi.new("SaStreamConfig *")
+
+        c_structure.redetect_interval = self.redetect_interval
+        c_structure.roi_margin = self.roi_margin
+        c_structure.min_overlap = self.min_overlap
+        c_structure.max_missed_frames = self.max_missed_frames
+        c_structure.disable_scl = self.disable_scl
+
+        c_structure.change_gate = self.change_gate
+        c_structure.change_gate_threshold = self.change_gate_threshold
+        c_structure.change_gate_downscale = self.change_gate_downscale
+        c_structure.change_gate_learning_rate = self.change_gate_learning_rate
+        c_structure.change_gate_refresh_interval = self.change_gate_refresh_interval
+
+        return c_structure
+
+
+class SaTrack:
+    """Mirror of SaTrack structure."""
+
+    def __init__(self):
+        self.track_id = 0
+        self.detection = SaDetection()
+        self.num_frames = 0
+        self.finished = False
+        self.scl_result = None
+        self.best_frame = 0
+
+    def c_init(self, ffi: FFI, c_structure):
+        """
+        Fills this mirror structure with given C structure data.
+        :param ffi: Instance of the FFI class.
+        :param c_structure: C structure data.
+        """
+        if c_structure == ffi.NULL:
+            return
+
+        self.track_id = c_structure.track_id
+        self.detection.c_init(ffi, ffi.addressof(c_structure, "detection"))
+        self.num_frames = c_structure.num_frames
+        self.finished = bool(c_structure.finished)
+        if c_structure.has_scl:
+            self.scl_result = SaSclResult()
+            self.scl_result.c_init(ffi, ffi.addressof(c_structure, "scl_result"))
+        self.best_frame = c_structure.best_frame
+
+
+class SaStreamResult:
+    """Mirror of SaStreamResult structure."""
+
+    def __init__(self):
+        self.frame_index = 0
+        self.full_detection = False
+        self.gated = False
+        self.num_tracks = 0
+        self.tracks = []
+
+    def c_init(self, ffi: FFI, c_structure):
+        """
+        Fills this mirror structure with given C structure data.
+        :param ffi: Instance of the FFI class.
+        :param c_structure: C structure data.
+        """
+        if c_structure == ffi.NULL:
+            return
+
+        self.frame_index = c_structure.frame_index
+        self.full_detection = bool(c_structure.full_detection)
+        self.gated = bool(c_structure.gated)
+        self.num_tracks = c_structure.num_tracks
+        self.tracks = []
+        for i in range(c_structure.num_tracks):
+            track = SaTrack()
+            track.c_init(ffi, c_structure.tracks + i)
+            self.tracks.append(track)
+
+
+class SaStream:
+    """
+    Python wrapper class for Seatsanalyzer video stream, created by Seatsanalyzer.create_stream
+    """
+
+    def __init__(self, ffi: FFI, sa_lib, sa_stream, seatsanalyzer) -> None:
+        self.ffi = ffi
+        self.__sa = sa_lib
+        self.__sa_stream = self.ffi.gc(sa_stream, self._free_stream)
+        # the stream uses the state of the Seatsanalyzer, keep it alive
+        self.__seatsanalyzer = seatsanalyzer
+
+    def _free_stream(self, _):
+        self.__sa.saStreamFree(self.__sa_stream[0])
+
+    def __wrap_result(self, return_value, c_stream_result, function_name) -> SaStreamResult:
+        # Check the output
+        if return_value != 0:
+            raise SaError(function_name, return_value)
+
+        # Wrap the result
+        stream_result = SaStreamResult()
+        stream_result.c_init(self.ffi, c_stream_result)
+
+        # Free the result
+        self.__sa.saFreeStreamResult(self.__sa_stream[0], c_stream_result)
+
+        return stream_result
+
+    def process(self, image) -> SaStreamResult:
+        """
+        :param image: ERImage with the next frame of the stream.
+        :return: SaStreamResult with active tracks and tracks finished by the frame.
+        """
+        c_stream_result = self.ffi.new("SaStreamResult *")
+        return_value = self.__sa.saStreamProcess(self.__sa_stream[0], image[0], c_stream_result)
+        return self.__wrap_result(return_value, c_stream_result, "SaStreamProcess")
+
+    def flush(self) -> SaStreamResult:
+        """
+        Finishes and classifies all active tracks.
+        :return: SaStreamResult with the finished tracks.
+        """
+        c_stream_result = self.ffi.new("SaStreamResult *")
+        return_value = self.__sa.saStreamFlush(self.__sa_stream[0], c_stream_result)
+        return self.__wrap_result(return_value, c_stream_result, "SaStreamFlush")
+
+    def get_stats(self) -> dict:
+        """
+        :return: Counters of the stream as a dict, see SaStreamStats.
+        """
+        c_stats = self.ffi.new("SaStreamStats *")
+
+        return_value = self.__sa.saStreamGetStats(self.__sa_stream[0], c_stats)
+
+        if return_value != 0:
+            raise SaError("SaStreamGetStats", return_value)
+
+        return {field: getattr(c_stats, field) for field, _ in self.ffi.typeof("SaStreamStats").fields}
+
+
 class Seatsanalyzer:
     """
     Python wrapper class for Seatsanalyzer
@@ -236,16 +577,81 @@ class Seatsanalyzer:
                 #define SA_LABEL_STRING_LENGTH 255
                 #define SA_MAX_PATH 4096
                 #define NUM_CONF_OUTPUTS 3
+                #define SA_RESULT_PENDING 1000
+                #define SA_RESULT_TIMEOUT 1001
+                #define SA_RESULT_BUFFER_TOO_SMALL 1002
+                #define SA_RESULT_CONFIG_SIZE_MISMATCH 1003
         """)
         ffi.cdef("""
                 typedef void *SAState;
         """)
+        ffi.cdef("""
+                #define SA_NUM_STAGES 6
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    unsigned long long count;
+                    double             total_ms;
+                    double             p50_ms;
+                    double             p95_ms;
+                    double             p99_ms;
+                    double             max_ms;
+                } SaStageStats;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    SaStageStats       stages[SA_NUM_STAGES];
+                    unsigned long long num_allocations;
+                    unsigned long long bytes_allocated;
+                } SaStats;
+        """)
+        ffi.cdef("""
+                typedef void *SAStream;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    double total_ms;
+                    double config_ms;
+                    double det_plugin_ms;
+                    double scl_model_ms;
+                    double p_table_ms;
+                    double warmup_ms;
+                    int    det_mapped;
+                    int    scl_mapped;
+                } SaInitTiming;
+        """)
         ffi.cdef("""
                 typedef char SaDetectionLabel[SA_LABEL_STRING_LENGTH];
         """)
         ffi.cdef("""
                 typedef int  (*fcn_saInferenceCallback) (const ERImage*, unsigned char*);
         """)
+        ffi.cdef("""
+                typedef enum
+                {
+                    SA_MODEL_LOAD_HEAP = 0,
+                    SA_MODEL_LOAD_MMAP = 1
+                } SaModelLoadMode;
+        """)
+        ffi.cdef("""
+                typedef enum
+                {
+                    SA_CPU_DISPATCH_AUTO   = 0,
+                    SA_CPU_DISPATCH_SCALAR = 1,
+                    SA_CPU_DISPATCH_SSE4   = 2,
+                    SA_CPU_DISPATCH_AVX2   = 3
+                } SaCpuDispatch;
+        """)
+        ffi.cdef("""
+                typedef enum
+                {
+                    SA_PRECISION_FP32 = 0,
+                    SA_PRECISION_INT8 = 1
+                } SaPrecision;
+        """)
         ffi.cdef("""
                 typedef struct
                 {
@@ -270,6 +676,29 @@ class Seatsanalyzer:
                     fcn_saInferenceCallback scl_inference_callback;           /**< Callback funtion for external scl net inference (if NULL, external inferece is not used) */
                     unsigned int            scl_inference_output_buffer_size; /**< Byte size of output buffer from scl inference */
 
+                    // layout version
+                    unsigned int struct_size;
+
+                    // classification tasks
+                    unsigned int scl_task_mask;  /**< Classification tasks computed by default, zero for all tasks */
+
+                    // classification cascade
+                    int   scl_cascade;
+                    float scl_cascade_min_quality;
+                    float scl_cascade_min_occupied_confidence;
+
+                    // model loading
+                    SaModelLoadMode model_load_mode;
+
+                    // tracing
+                    const char* trace_filename;
+
+                    // image kernels
+                    SaCpuDispatch cpu_dispatch;
+
+                    // inference precision
+                    SaPrecision precision;
+
                 } SaConfig;
         """)
         ffi.cdef("""
@@ -319,26 +748,272 @@ class Seatsanalyzer:
                     SaPosition  right;
                 } SaSclResult;
         """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    SaDetection         detection;
+                    int                 has_scl;
+                    SaSclResult         scl_result;
+                } SaFullDetection;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    int                 num_detections;
+                    SaFullDetection    *detections;
+                } SaFullResult;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    float               scale_x;
+                    float               scale_y;
+                    float               offset_x;
+                    float               offset_y;
+                } SaScaleMapping;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    int   redetect_interval;
+                    float roi_margin;
+                    float min_overlap;
+                    int   max_missed_frames;
+                    int   disable_scl;
+
+                    int   change_gate;
+                    float change_gate_threshold;
+                    int   change_gate_downscale;
+                    float change_gate_learning_rate;
+                    int   change_gate_refresh_interval;
+                } SaStreamConfig;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    int                 track_id;
+                    SaDetection         detection;
+                    int                 num_frames;
+                    int                 finished;
+                    int                 has_scl;
+                    SaSclResult         scl_result;
+                    unsigned long long  best_frame;
+                } SaTrack;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    unsigned long long  frame_index;
+                    int                 full_detection;
+                    int                 gated;
+                    int                 num_tracks;
+                    SaTrack            *tracks;
+                } SaStreamResult;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    unsigned long long  frames;
+                    unsigned long long  full_detections;
+                    unsigned long long  roi_detections;
+                    unsigned long long  tracks;
+                    unsigned long long  scl_runs;
+                    unsigned long long  gated_frames;
+                } SaStreamStats;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    unsigned long long positions;
+                    unsigned long long skipped_low_quality;
+                    unsigned long long skipped_unoccupied;
+                    unsigned long long driver_computed;
+                    unsigned long long driver_skipped;
+                    unsigned long long belt_computed;
+                    unsigned long long belt_skipped;
+                    unsigned long long phone_computed;
+                    unsigned long long phone_skipped;
+                } SaCascadeStats;
+        """)
+        ffi.cdef("""
+                typedef int SaLabelId;
+        """)
+        ffi.cdef("""
+                #define SA_CLASS_FALSE 0
+                #define SA_CLASS_TRUE 1
+                #define SA_CLASS_UNKNOWN -1
+                #define SA_CLASS_UNDEFINED -2
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    ERRotatedRect       position;
+                    float               confidence;
+                    SaLabelId           label_id;
+                } SaCompactDetection;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    float       confidences[NUM_CONF_OUTPUTS];
+                    float       confidence;
+                    int8_t      result;
+                } SaCompactClass;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    float           quality;
+                    SaCompactClass  occupied;
+                    SaCompactClass  driver;
+                    SaCompactClass  belt;
+                    SaCompactClass  phone;
+                } SaCompactPosition;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    SaCompactPosition  left;
+                    SaCompactPosition  middle;
+                    SaCompactPosition  right;
+                } SaCompactSclResult;
+        """)
+        ffi.cdef("""
+                typedef unsigned long long SaTicket;
+        """)
+        ffi.cdef("""
+                typedef enum
+                {
+                    SA_TASK_DET = 0,
+                    SA_TASK_SCL = 1
+                } SaTaskType;
+        """)
+        ffi.cdef("""
+                typedef struct
+                {
+                    SaTicket            ticket;
+                    SaTaskType          task_type;
+                    int                 status;
+                    SaDetResult         det_result;
+                    SaSclResult         scl_result;
+                } SaTaskResult;
+        """)
+        ffi.cdef("""
+                typedef void (*fcn_saCompletionCallback) (const SaTaskResult *result, void *user_data);
+        """)
 
         # Function definitions from sa.h
         ffi.cdef("""
                 int saInit(const char *sa_config_path, const SaConfig* sa_config,  SAState *sa_state);
         """)
+        ffi.cdef("""
+                int saCloneState(SAState sa_state, SAState *sa_state_clone);
+        """)
+        ffi.cdef("""
+                int saGetInitTiming(SAState sa_state, SaInitTiming *timing);
+        """)
+        ffi.cdef("""
+                int saReloadModels(SAState sa_state, const char *sa_config_path, const SaConfig* sa_config);
+        """)
         ffi.cdef("""
                 void saFree(SAState sa_state);
         """)
         ffi.cdef("""
                 int saRunDet(SAState sa_state, const ERImage image, const ERRoI *bounding_box, SaDetResult *result);
         """)
+        ffi.cdef("""
+                int saRunDetBatch(SAState sa_state, const ERImage *images, const ERRoI * const *bounding_boxes, int num_images, SaDetResult *results);
+        """)
+        ffi.cdef("""
+                int saRunDetInto(SAState sa_state, const ERImage image, const ERRoI *bounding_box, SaDetection *detections, int capacity, int *num_detections);
+        """)
         ffi.cdef("""
                 void saFreeDetResult(SAState sa_state, SaDetResult *detection_result);
         """)
         ffi.cdef("""
                 int saRunScl(SAState sa_state, const ERImage image, const ERRotatedRect *position, const SaDetectionLabel detection_label, SaSclResult *result);
         """)
-
-    def __init__(self, ffi: FFI, sdk_lib_path: str, support_libs: list = None) -> None:
-        self.sdk_lib_path = sdk_lib_path
+        ffi.cdef("""
+                int saRunSclMasked(SAState sa_state, const ERImage image, const ERRotatedRect *position, const SaDetectionLabel detection_label, unsigned int task_mask, SaSclResult *result);
+        """)
+        ffi.cdef("""
+                int saRunSclBatch(SAState sa_state, const ERImage *images, int num_images, const int *image_indices, const ERRotatedRect *positions, const SaDetectionLabel *detection_labels, int num_crops, SaSclResult *results);
+        """)
+        ffi.cdef("""
+                int saRunDetScl(SAState sa_state, const ERImage image, const ERRoI *bounding_box, SaFullResult *result);
+        """)
+        ffi.cdef("""
+                int saRunDetSclDual(SAState sa_state, const ERImage det_image, const ERImage scl_image, const SaScaleMapping *mapping, const ERRoI *bounding_box, SaFullResult *result);
+        """)
+        ffi.cdef("""
+                void saFreeFullResult(SAState sa_state, SaFullResult *full_result);
+        """)
+        ffi.cdef("""
+                int saMapRotatedRect(const SaScaleMapping *mapping, const ERRotatedRect *position, int inverse, ERRotatedRect *mapped);
+        """)
+        ffi.cdef("""
+                int saGetStats(SAState sa_state, SaStats *stats);
+        """)
+        ffi.cdef("""
+                void saResetStats(SAState sa_state);
+        """)
+        ffi.cdef("""
+                int saTraceStart(SAState sa_state, unsigned int max_events_per_thread);
+        """)
+        ffi.cdef("""
+                int saTraceStop(SAState sa_state, const char *trace_filename);
+        """)
+        ffi.cdef("""
+                int saGetCascadeStats(SAState sa_state, SaCascadeStats *stats);
+        """)
+        ffi.cdef("""
+                void saResetCascadeStats(SAState sa_state);
+        """)
+        ffi.cdef("""
+                int saRunDetCompact(SAState sa_state, const ERImage image, const ERRoI *bounding_box, SaCompactDetection *detections, int capacity, int *num_detections);
+        """)
+        ffi.cdef("""
+                int saRunSclCompact(SAState sa_state, const ERImage image, const ERRotatedRect *position, SaLabelId label_id, SaCompactSclResult *result);
+        """)
+        ffi.cdef("""
+                const char* saGetLabelName(SAState sa_state, SaLabelId label_id);
+        """)
+        ffi.cdef("""
+                SaLabelId saGetLabelId(SAState sa_state, const char *label);
+        """)
+        ffi.cdef("""
+                int saStreamCreate(SAState sa_state, const SaStreamConfig *stream_config, SAStream *sa_stream);
+        """)
+        ffi.cdef("""
+                void saStreamFree(SAStream sa_stream);
+        """)
+        ffi.cdef("""
+                int saStreamProcess(SAStream sa_stream, const ERImage image, SaStreamResult *result);
+        """)
+        ffi.cdef("""
+                int saStreamFlush(SAStream sa_stream, SaStreamResult *result);
+        """)
+        ffi.cdef("""
+                void saFreeStreamResult(SAStream sa_stream, SaStreamResult *stream_result);
+        """)
+        ffi.cdef("""
+                int saStreamGetStats(SAStream sa_stream, SaStreamStats *stats);
+        """)
+        ffi.cdef("""
+                int saSubmitDet(SAState sa_state, const ERImage image, const ERRoI *bounding_box, fcn_saCompletionCallback callback, void *user_data, SaTicket *ticket);
+        """)
+        ffi.cdef("""
+                int saSubmitScl(SAState sa_state, const ERImage image, const ERRotatedRect *position, const SaDetectionLabel detection_label, fcn_saCompletionCallback callback, void *user_data, SaTicket *ticket);
+        """)
+        ffi.cdef("""
+                int saPoll(SAState sa_state, SaTicket ticket, SaTaskResult *result);
+        """)
+        ffi.cdef("""
+                int saWait(SAState sa_state, SaTicket ticket, int timeout_ms, SaTaskResult *result);
+        """)
+
+    def __init__(self, ffi: FFI, sdk_lib_path: str, support_libs: list = None) -> None:
+        self.sdk_lib_path = sdk_lib_path
         if type(self.sdk_lib_path) is not str:
             raise TypeError("Variable sdk_dir_path must be a string.")
 
@@ -356,6 +1031,16 @@ class Seatsanalyzer:
 
         self.__sa_state = self.ffi.new("SAState *", self.ffi.NULL)
 
+        # images of pending asynchronous tasks, kept alive until the result is collected
+        self.__pending_images = {}
+
+        # detection buffer reused by run_det_into, grown when needed
+        self.__det_buffer = self.ffi.new("SaDetection []", 16)
+
+        # compact buffers reused by run_det_np and run_scl_np, the detection one grown when needed
+        self.__compact_det_buffer = self.ffi.new("SaCompactDetection []", 16)
+        self.__compact_scl_buffer = self.ffi.new("SaCompactSclResult *")
+
     def _free_sa(self, _):
         self.__sa.saFree(self.__sa_state[0])
 
@@ -383,6 +1068,171 @@ class Seatsanalyzer:
 
         self.__sa_state = self.ffi.gc(self.__sa_state, self._free_sa)
 
+    def reload_models(self, sa_config_path: Optional[str] = None, sa_config: Optional[SaConfig] = None):
+        """
+        Reloads the models of this instance and all its clones, calls in progress finish with the old models.
+        May be called from another thread while this instance is processing images.
+        :param sa_config_path: Optional path to configuration file, the path given to init is used if None.
+        :param sa_config: Optional configuration structure, only the model paths and loading mode are used.
+        """
+        if sa_config_path is None:
+            c_sa_config_path = self.ffi.NULL
+        else:
+            c_sa_config_path = self.ffi.new("const char []", sa_config_path.encode("utf-8"))
+
+        if sa_config is None:
+            c_sa_config = self.ffi.NULL
+        else:
+            c_sa_config = sa_config.get_c(self.ffi)
+
+        ret_code = self.__sa.saReloadModels(self.__sa_state[0], c_sa_config_path, c_sa_config)
+
+        if ret_code != 0:
+            raise SaError("saReloadModels", ret_code)
+
+    def get_init_timing(self) -> dict:
+        """
+        :return: Timing breakdown of saInit as a dict, see SaInitTiming.
+        """
+        c_timing = self.ffi.new("SaInitTiming *")
+
+        return_value = self.__sa.saGetInitTiming(self.__sa_state[0], c_timing)
+
+        if return_value != 0:
+            raise SaError("SaGetInitTiming", return_value)
+
+        return {field: getattr(c_timing, field) for field, _ in self.ffi.typeof("SaInitTiming").fields}
+
+    def clone(self):
+        """
+        Creates a new Seatsanalyzer sharing the loaded models with this one.
+        A single instance must not be used by several threads at once, use one clone per thread instead.
+        :return: Initialized Seatsanalyzer instance.
+        """
+        if self.__sa_state[0] == self.ffi.NULL:
+            raise SaError("saCloneState", -1)
+
+        sa_clone = Seatsanalyzer.__new__(Seatsanalyzer)
+        sa_clone.sdk_lib_path = self.sdk_lib_path
+        sa_clone.ffi = self.ffi
+        sa_clone.__sa = self.__sa
+        sa_clone.__sa_state = self.ffi.new("SAState *", self.ffi.NULL)
+        sa_clone.__pending_images = {}
+        sa_clone.__det_buffer = self.ffi.new("SaDetection []", len(self.__det_buffer))
+        sa_clone.__compact_det_buffer = self.ffi.new("SaCompactDetection []", len(self.__compact_det_buffer))
+        sa_clone.__compact_scl_buffer = self.ffi.new("SaCompactSclResult *")
+
+        ret_code = self.__sa.saCloneState(self.__sa_state[0], sa_clone.__sa_state)
+
+        if ret_code != 0:
+            raise SaError("saCloneState", ret_code)
+
+        sa_clone.__sa_state = self.ffi.gc(sa_clone.__sa_state, sa_clone._free_sa)
+
+        return sa_clone
+
+    def create_stream(self, stream_config: Optional[SaStreamConfig] = None) -> SaStream:
+        """
+        Creates a video stream using the state of this Seatsanalyzer.
+        :param stream_config: Optional stream configuration, default configuration is used if None.
+        :return: SaStream
+        """
+        if stream_config is None:
+            c_stream_config = self.ffi.NULL
+        else:
+            c_stream_config = stream_config.get_c(self.ffi)
+
+        c_sa_stream = self.ffi.new("SAStream *", self.ffi.NULL)
+
+        return_value = self.__sa.saStreamCreate(self.__sa_state[0], c_stream_config, c_sa_stream)
+
+        if return_value != 0:
+            raise SaError("saStreamCreate", return_value)
+
+        return SaStream(self.ffi, self.__sa, c_sa_stream, self)
+
+    def get_stats(self) -> dict:
+        """
+        :return: Processing statistics as a dict, stages are indexed by names from SA_STAGE_NAMES, see SaStats.
+        """
+        c_stats = self.ffi.new("SaStats *")
+
+        return_value = self.__sa.saGetStats(self.__sa_state[0], c_stats)
+
+        if return_value != 0:
+            raise SaError("SaGetStats", return_value)
+
+        stage_fields = [field for field, _ in self.ffi.typeof("SaStageStats").fields]
+        stats = {}
+        for i, stage_name in enumerate(SA_STAGE_NAMES):
+            stats[stage_name] = {field: getattr(c_stats.stages[i], field) for field in stage_fields}
+        stats["num_allocations"] = c_stats.num_allocations
+        stats["bytes_allocated"] = c_stats.bytes_allocated
+
+        return stats
+
+    def reset_stats(self):
+        """Resets the processing statistics."""
+        self.__sa.saResetStats(self.__sa_state[0])
+
+    def trace_start(self, max_events_per_thread: int = 0):
+        """
+        Starts recording of trace spans of this state and its clones.
+        :param max_events_per_thread: Capacity of the per-thread ring buffers, zero for default.
+        """
+        return_value = self.__sa.saTraceStart(self.__sa_state[0], max_events_per_thread)
+
+        if return_value != 0:
+            raise SaError("SaTraceStart", return_value)
+
+    def trace_stop(self, trace_filename: Optional[str] = None):
+        """
+        Stops recording of trace spans and writes them in Chrome trace JSON format.
+        :param trace_filename: Output JSON file, None to discard the recorded spans.
+        """
+        c_filename = self.ffi.new("const char []", trace_filename.encode("utf-8")) \
+            if trace_filename is not None else self.ffi.NULL
+
+        return_value = self.__sa.saTraceStop(self.__sa_state[0], c_filename)
+
+        if return_value != 0:
+            raise SaError("SaTraceStop", return_value)
+
+    def get_cascade_stats(self) -> dict:
+        """
+        :return: Counters of the classification cascade as a dict, shared with the clones, see SaCascadeStats.
+        """
+        c_stats = self.ffi.new("SaCascadeStats *")
+
+        return_value = self.__sa.saGetCascadeStats(self.__sa_state[0], c_stats)
+
+        if return_value != 0:
+            raise SaError("SaGetCascadeStats", return_value)
+
+        return {field: getattr(c_stats, field) for field, _ in self.ffi.typeof("SaCascadeStats").fields}
+
+    def reset_cascade_stats(self):
+        """Resets counters of the classification cascade."""
+        self.__sa.saResetCascadeStats(self.__sa_state[0])
+
+    def get_label_name(self, label_id: int) -> Optional[str]:
+        """
+        :param label_id: Numeric detection label.
+        :return: String detection label, None for an unknown label.
+        """
+        c_label = self.__sa.saGetLabelName(self.__sa_state[0], label_id)
+        if c_label == self.ffi.NULL:
+            return None
+        return self.ffi.string(c_label).decode("utf-8")
+
+    def get_label_id(self, label: str) -> int:
+        """
+        The id is valid only until the next reload_models(), query it again after a reload.
+        :param label: String detection label, e.g. "window".
+        :return: Numeric detection label, negative for an unknown label.
+        """
+        return self.__sa.saGetLabelId(self.__sa_state[0], label.encode("utf-8"))
+
     def run_det(self, image, roi: ERRoI = None) -> SaDetResult:
         # Unwrap the input parameters
         c_image = image[0]
@@ -410,7 +1260,145 @@ class Seatsanalyzer:
 
         return detection_result
 
-    def run_scl(self, image, bounding_box: ERRotatedRect = None, detection_label: str = "") -> SaSclResult:
+    def run_det_into(self, image, roi: ERRoI = None) -> SaDetResult:
+        """
+        Same as run_det, but the detections are written into a buffer kept by this object, no result is allocated
+        by SDK. Requires an SDK providing saRunDetInto.
+        If the buffer overflows, it is grown to twice the reported number of detections and the detection is run
+        again, so the repeated inference is paid only until the buffer fits the processed images.
+        :param image: ERImage.
+        :param roi: Optional Region of Interest.
+        :return: Detection result.
+        """
+        # Unwrap the input parameters
+        c_image = image[0]
+        if roi is not None:
+            c_bounding_box = roi.get_c(self.ffi)
+        else:
+            c_bounding_box = self.ffi.NULL
+
+        # Call the C function, detections are written to the reused buffer
+        c_num_detections = self.ffi.new("int *")
+        det_return_value = self.__sa.saRunDetInto(self.__sa_state[0], c_image, c_bounding_box, self.__det_buffer,
+                                                  len(self.__det_buffer), c_num_detections)
+        if det_return_value == self.__sa.SA_RESULT_BUFFER_TOO_SMALL:
+            self.__det_buffer = self.ffi.new("SaDetection []", 2 * c_num_detections[0])
+            det_return_value = self.__sa.saRunDetInto(self.__sa_state[0], c_image, c_bounding_box,
+                                                      self.__det_buffer, len(self.__det_buffer), c_num_detections)
+
+        # Check the output
+        if det_return_value != 0:
+            raise SaError("SaRunDetInto", det_return_value)
+
+        # Wrap the result
+        c_det_result = self.ffi.new("SaDetResult *")
+        c_det_result.num_detections = c_num_detections[0]
+        c_det_result.detections = self.__det_buffer
+        detection_result = SaDetResult()
+        detection_result.c_init(self.ffi, c_det_result)
+
+        return detection_result
+
+    def run_det_np(self, image, roi: ERRoI = None) -> np.ndarray:
+        """
+        Runs detection and returns the detections as a numpy structured array, no Python object is built per detection.
+        The C call runs with the GIL released, use one clone per thread to process images from several Python threads.
+        :param image: ERImage.
+        :param roi: Optional Region of Interest.
+        :return: Array of SA_COMPACT_DETECTION_DTYPE with N elements, result["position"] is (N, 5) float32 array
+                 of x, y, width, height and angle, result["confidence"] and result["label_id"] are (N,) arrays,
+                 see get_label_name.
+        """
+        # Unwrap the input parameters
+        c_image = image[0]
+        if roi is not None:
+            c_bounding_box = roi.get_c(self.ffi)
+        else:
+            c_bounding_box = self.ffi.NULL
+
+        # Call the C function, detections are written to the reused buffer
+        c_num_detections = self.ffi.new("int *")
+        det_return_value = self.__sa.saRunDetCompact(self.__sa_state[0], c_image, c_bounding_box,
+                                                     self.__compact_det_buffer, len(self.__compact_det_buffer),
+                                                     c_num_detections)
+        if det_return_value == self.__sa.SA_RESULT_BUFFER_TOO_SMALL:
+            # grown with headroom, the repeated inference is paid only until the buffer fits the processed images
+            self.__compact_det_buffer = self.ffi.new("SaCompactDetection []", 2 * c_num_detections[0])
+            det_return_value = self.__sa.saRunDetCompact(self.__sa_state[0], c_image, c_bounding_box,
+                                                         self.__compact_det_buffer, len(self.__compact_det_buffer),
+                                                         c_num_detections)
+
+        # Check the output
+        if det_return_value != 0:
+            raise SaError("SaRunDetCompact", det_return_value)
+
+        # Single copy of the used part of the buffer
+        num_bytes = c_num_detections[0] * SA_COMPACT_DETECTION_DTYPE.itemsize
+        return np.frombuffer(self.ffi.buffer(self.__compact_det_buffer, num_bytes),
+                             dtype=SA_COMPACT_DETECTION_DTYPE).copy()
+
+    def run_det_batch(self, images: list, rois: list = None) -> list:
+        """
+        Runs detection on all images as a single batch.
+        :param images: List of ERImages.
+        :param rois: Optional list of ERRoI (or None) with the same length as images.
+        :return: List of SaDetResult, one per image.
+        """
+        num_images = len(images)
+        if num_images == 0:
+            return []
+        if rois is not None and len(rois) != num_images:
+            raise ValueError("Lists images and rois must have the same length.")
+
+        # Unwrap the input parameters
+        c_images = self.ffi.new("ERImage []", num_images)
+        for i, image in enumerate(images):
+            c_images[i] = image[0]
+
+        c_rois = []
+        if rois is not None:
+            c_bounding_boxes = self.ffi.new("ERRoI *[]", num_images)
+            for i, roi in enumerate(rois):
+                if roi is not None:
+                    c_roi = roi.get_c(self.ffi)
+                    # keep the structure alive until the call is finished
+                    c_rois.append(c_roi)
+                    c_bounding_boxes[i] = c_roi
+                else:
+                    c_bounding_boxes[i] = self.ffi.NULL
+        else:
+            c_bounding_boxes = self.ffi.NULL
+
+        # Create det result array
+        c_det_results = self.ffi.new("SaDetResult []", num_images)
+
+        # Call the C function
+        det_return_value = self.__sa.saRunDetBatch(self.__sa_state[0], c_images, c_bounding_boxes, num_images,
+                                                   c_det_results)
+
+        # Check the output
+        if det_return_value != 0:
+            raise SaError("SaRunDetBatch", det_return_value)
+
+        # Wrap and free the results
+        detection_results = []
+        for i in range(num_images):
+            detection_result = SaDetResult()
+            detection_result.c_init(self.ffi, c_det_results + i)
+            detection_results.append(detection_result)
+            self.__sa.saFreeDetResult(self.__sa_state[0], c_det_results + i)
+
+        return detection_results
+
+    def run_scl(self, image, bounding_box: ERRotatedRect = None, detection_label: str = "",
+                task_mask: Optional[int] = None) -> SaSclResult:
+        """
+        :param image: ERImage.
+        :param bounding_box: Detection position.
+        :param detection_label: Detection label.
+        :param task_mask: Optional classification task mask (see sa_scl_all_positions), SaConfig.scl_task_mask is used if None.
+        :return: SaSclResult
+        """
         # Unwrap the input parameters
         c_image = image[0]
         if bounding_box is not None:
@@ -423,8 +1411,12 @@ class Seatsanalyzer:
         c_scl_result = self.ffi.new("SaSclResult *")
 
         # Call the C function
-        scl_return_value = self.__sa.saRunScl(self.__sa_state[0], c_image, c_bounding_box, c_detection_label,
-                                              c_scl_result)
+        if task_mask is None:
+            scl_return_value = self.__sa.saRunScl(self.__sa_state[0], c_image, c_bounding_box, c_detection_label,
+                                                  c_scl_result)
+        else:
+            scl_return_value = self.__sa.saRunSclMasked(self.__sa_state[0], c_image, c_bounding_box,
+                                                        c_detection_label, task_mask, c_scl_result)
 
         # Check the output
         if scl_return_value != 0:
@@ -439,3 +1431,294 @@ class Seatsanalyzer:
 
         return classification_result
 
+    def run_scl_np(self, image, position, label_id) -> np.ndarray:
+        """
+        Runs seat classification and returns the result as a numpy structured array, no Python object is built per task.
+        The C call runs with the GIL released, use one clone per thread to process images from several Python threads.
+        :param image: ERImage.
+        :param position: Detection position, ERRotatedRect or sequence of x, y, width, height and angle,
+                         e.g. a row of run_det_np()["position"].
+        :param label_id: Numeric detection label, e.g. a value of run_det_np()["label_id"], or string label.
+        :return: Array of SA_COMPACT_POSITION_DTYPE with 3 elements - left, middle and right position,
+                 e.g. result["belt"]["result"] holds SA_CLASS_* values of all positions.
+        """
+        # Unwrap the input parameters
+        c_image = image[0]
+        if isinstance(position, ERRotatedRect):
+            c_position = position.get_c(self.ffi)
+        else:
+            c_position = self.ffi.new("ERRotatedRect *", [float(value) for value in position])
+        if isinstance(label_id, str):
+            label_id = self.get_label_id(label_id)
+
+        # Call the C function
+        scl_return_value = self.__sa.saRunSclCompact(self.__sa_state[0], c_image, c_position, int(label_id),
+                                                     self.__compact_scl_buffer)
+
+        # Check the output
+        if scl_return_value != 0:
+            raise SaError("SaRunSclCompact", scl_return_value)
+
+        return np.frombuffer(self.ffi.buffer(self.__compact_scl_buffer), dtype=SA_COMPACT_POSITION_DTYPE).copy()
+
+    def run_scl_batch(self, images: list, image_indices: list, bounding_boxes: list, detection_labels: list) -> list:
+        """
+        Runs seat classification on all crops as a single batch.
+        :param images: List of ERImages the crops are taken from.
+        :param image_indices: List of indices to images, one per crop.
+        :param bounding_boxes: List of ERRotatedRect crop positions.
+        :param detection_labels: List of detection labels, one per crop.
+        :return: List of SaSclResult, one per crop.
+        """
+        num_crops = len(bounding_boxes)
+        if len(image_indices) != num_crops or len(detection_labels) != num_crops:
+            raise ValueError("Lists image_indices, bounding_boxes and detection_labels must have the same length.")
+        if num_crops == 0:
+            return []
+
+        # Unwrap the input parameters
+        num_images = len(images)
+        c_images = self.ffi.new("ERImage []", num_images)
+        for i, image in enumerate(images):
+            c_images[i] = image[0]
+
+        c_image_indices = self.ffi.new("int []", image_indices)
+        c_positions = self.ffi.new("ERRotatedRect []", num_crops)
+        c_detection_labels = self.ffi.new("SaDetectionLabel []", num_crops)
+        for i in range(num_crops):
+            c_positions[i] = bounding_boxes[i].get_c(self.ffi)[0]
+            c_detection_labels[i] = detection_labels[i].encode("utf-8")
+
+        # Create scl result array
+        c_scl_results = self.ffi.new("SaSclResult []", num_crops)
+
+        # Call the C function
+        scl_return_value = self.__sa.saRunSclBatch(self.__sa_state[0], c_images, num_images, c_image_indices,
+                                                   c_positions, c_detection_labels, num_crops, c_scl_results)
+
+        # Check the output
+        if scl_return_value != 0:
+            raise SaError("SaRunSclBatch", scl_return_value)
+
+        # Wrap the results
+        classification_results = []
+        for i in range(num_crops):
+            classification_result = SaSclResult()
+            classification_result.c_init(self.ffi, c_scl_results + i)
+            classification_results.append(classification_result)
+
+        # Free the scl_results
+        self.ffi.release(c_scl_results)
+
+        return classification_results
+
+    def run_det_scl(self, image, roi: ERRoI = None) -> SaFullResult:
+        """
+        Runs detection and classification of all supported detections in a single call.
+        :param image: ERImage.
+        :param roi: Optional region of interest for detection.
+        :return: SaFullResult with detections and their classification.
+        """
+        # Unwrap the input parameters
+        c_image = image[0]
+        if roi is not None:
+            c_bounding_box = roi.get_c(self.ffi)
+        else:
+            c_bounding_box = self.ffi.NULL
+
+        # Create full result pointer
+        c_full_result = self.ffi.new("SaFullResult *")
+
+        # Call the C function
+        return_value = self.__sa.saRunDetScl(self.__sa_state[0], c_image, c_bounding_box, c_full_result)
+
+        # Check the output
+        if return_value != 0:
+            raise SaError("SaRunDetScl", return_value)
+
+        # Wrap the result
+        full_result = SaFullResult()
+        full_result.c_init(self.ffi, c_full_result)
+
+        # Free the result
+        self.__sa.saFreeFullResult(self.__sa_state[0], c_full_result)
+
+        return full_result
+
+    def run_det_scl_dual(self, det_image, scl_image, mapping: SaScaleMapping = None,
+                         roi: ERRoI = None) -> SaFullResult:
+        """
+        Runs detection on a reduced-resolution image and classification on a full-resolution image in a single call.
+        :param det_image: ERImage for detection, e.g. a preview sub-stream frame.
+        :param scl_image: ERImage for classification showing the same scene.
+        :param mapping: Optional mapping from det_image to scl_image coordinates, derived from the image sizes if None.
+        :param roi: Optional region of interest for detection in det_image coordinates.
+        :return: SaFullResult with positions in scl_image coordinates.
+        """
+        # Unwrap the input parameters
+        c_det_image = det_image[0]
+        c_scl_image = scl_image[0]
+        if mapping is not None:
+            c_mapping = mapping.get_c(self.ffi)
+        else:
+            c_mapping = self.ffi.NULL
+        if roi is not None:
+            c_bounding_box = roi.get_c(self.ffi)
+        else:
+            c_bounding_box = self.ffi.NULL
+
+        # Create full result pointer
+        c_full_result = self.ffi.new("SaFullResult *")
+
+        # Call the C function
+        return_value = self.__sa.saRunDetSclDual(self.__sa_state[0], c_det_image, c_scl_image, c_mapping,
+                                                 c_bounding_box, c_full_result)
+
+        # Check the output
+        if return_value != 0:
+            raise SaError("SaRunDetSclDual", return_value)
+
+        # Wrap the result
+        full_result = SaFullResult()
+        full_result.c_init(self.ffi, c_full_result)
+
+        # Free the result
+        self.__sa.saFreeFullResult(self.__sa_state[0], c_full_result)
+
+        return full_result
+
+    def map_rotated_rect(self, mapping: SaScaleMapping, position: ERRotatedRect,
+                         inverse: bool = False) -> ERRotatedRect:
+        """
+        Maps a position between the detection and classification image coordinates.
+        :param mapping: Mapping from the detection image to the classification image coordinates.
+        :param position: ERRotatedRect to map.
+        :param inverse: Maps from the classification image to the detection image if True.
+        :return: Mapped ERRotatedRect.
+        """
+        c_position = position.get_c(self.ffi)
+        c_mapped = self.ffi.new("ERRotatedRect *")
+
+        # Call the C function
+        return_value = self.__sa.saMapRotatedRect(mapping.get_c(self.ffi), c_position, 1 if inverse else 0, c_mapped)
+
+        # Check the output
+        if return_value != 0:
+            raise SaError("SaMapRotatedRect", return_value)
+
+        mapped = ERRotatedRect()
+        mapped.c_init(self.ffi, c_mapped)
+        return mapped
+
+    def submit_det(self, image, roi: ERRoI = None) -> int:
+        """
+        Submits detection to the asynchronous work queue.
+        Completion callbacks are not supported by the wrapper, collect the result by poll or wait.
+        :param image: ERImage, kept alive until the result is collected.
+        :param roi: Optional region of interest for detection.
+        :return: Ticket of the submitted task.
+        """
+        # Unwrap the input parameters
+        c_image = image[0]
+        if roi is not None:
+            c_bounding_box = roi.get_c(self.ffi)
+        else:
+            c_bounding_box = self.ffi.NULL
+        c_ticket = self.ffi.new("SaTicket *")
+
+        # Call the C function
+        return_value = self.__sa.saSubmitDet(self.__sa_state[0], c_image, c_bounding_box, self.ffi.NULL,
+                                             self.ffi.NULL, c_ticket)
+
+        # Check the output
+        if return_value != 0:
+            raise SaError("SaSubmitDet", return_value)
+
+        self.__pending_images[c_ticket[0]] = image
+        return c_ticket[0]
+
+    def submit_scl(self, image, bounding_box: ERRotatedRect = None, detection_label: str = "") -> int:
+        """
+        Submits seat classification to the asynchronous work queue.
+        Completion callbacks are not supported by the wrapper, collect the result by poll or wait.
+        :param image: ERImage, kept alive until the result is collected.
+        :param bounding_box: Detection position.
+        :param detection_label: Detection label.
+        :return: Ticket of the submitted task.
+        """
+        # Unwrap the input parameters
+        c_image = image[0]
+        if bounding_box is not None:
+            c_bounding_box = bounding_box.get_c(self.ffi)
+        else:
+            c_bounding_box = self.ffi.NULL
+        c_detection_label = self.ffi.new("const char []", detection_label.encode("utf-8"))
+        c_ticket = self.ffi.new("SaTicket *")
+
+        # Call the C function
+        return_value = self.__sa.saSubmitScl(self.__sa_state[0], c_image, c_bounding_box, c_detection_label,
+                                             self.ffi.NULL, self.ffi.NULL, c_ticket)
+
+        # Check the output
+        if return_value != 0:
+            raise SaError("SaSubmitScl", return_value)
+
+        self.__pending_images[c_ticket[0]] = image
+        return c_ticket[0]
+
+    def _wrap_task_result(self, ticket: int, c_task_result):
+        # The image is not referenced by the SDK anymore
+        self.__pending_images.pop(ticket, None)
+
+        if c_task_result.status != 0:
+            if c_task_result.task_type == self.__sa.SA_TASK_DET:
+                raise SaError("SaRunDet", c_task_result.status)
+            raise SaError("SaRunScl", c_task_result.status)
+
+        if c_task_result.task_type == self.__sa.SA_TASK_DET:
+            c_det_result = self.ffi.addressof(c_task_result, "det_result")
+            detection_result = SaDetResult()
+            detection_result.c_init(self.ffi, c_det_result)
+            self.__sa.saFreeDetResult(self.__sa_state[0], c_det_result)
+            return detection_result
+
+        classification_result = SaSclResult()
+        classification_result.c_init(self.ffi, self.ffi.addressof(c_task_result, "scl_result"))
+        return classification_result
+
+    def poll(self, ticket: int):
+        """
+        Checks whether an asynchronous task is finished.
+        :param ticket: Ticket returned by submit_det or submit_scl.
+        :return: SaDetResult or SaSclResult if the task is finished, None otherwise.
+        """
+        c_task_result = self.ffi.new("SaTaskResult *")
+
+        return_value = self.__sa.saPoll(self.__sa_state[0], ticket, c_task_result)
+
+        if return_value == self.__sa.SA_RESULT_PENDING:
+            return None
+        if return_value != 0:
+            self.__pending_images.pop(ticket, None)
+            raise SaError("SaPoll", return_value)
+
+        return self._wrap_task_result(ticket, c_task_result)
+
+    def wait(self, ticket: int, timeout_ms: int = -1):
+        """
+        Waits until an asynchronous task is finished.
+        :param ticket: Ticket returned by submit_det or submit_scl.
+        :param timeout_ms: Maximal waiting time in milliseconds, negative value waits without limit.
+        :return: SaDetResult or SaSclResult if the task is finished, None if the timeout expired.
+        """
+        c_task_result = self.ffi.new("SaTaskResult *")
+
+        return_value = self.__sa.saWait(self.__sa_state[0], ticket, timeout_ms, c_task_result)
+
+        if return_value == self.__sa.SA_RESULT_TIMEOUT:
+            return None
+        if return_value != 0:
+            self.__pending_images.pop(ticket, None)
+            raise SaError("SaWait", return_value)
+
+        return self._wrap_task_result(ticket, c_task_result)
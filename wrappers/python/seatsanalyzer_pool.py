@@ -0,0 +1,296 @@
+"""
+Pool of Seatsanalyzer workers processing frames in parallel.
+
+Frames are copied once into a ring of fixed-size slots, the workers wrap the slots as ERImages without copying
+(see ER.wrap_nparray). With worker processes the ring lives in shared memory, so the pixel data are never pickled,
+only slot indices and small numpy results pass through the queues.
+"""
+
+import queue
+import threading
+import multiprocessing
+from multiprocessing import shared_memory
+from typing import Iterable, Iterator, Optional, Tuple
+import numpy as np
+from cffi import FFI
+
+from er import ER
+from seatsanalyzer import Seatsanalyzer, SaConfig, SaError
+
+TASK_DET = 0
+TASK_SCL = 1
+
+# interval of the worker liveness checks while waiting for a result [s]
+WORKER_POLL_INTERVAL = 1.0
+
+# byte alignment of the ring slots
+SLOT_ALIGNMENT = 64
+
+
+def _process_task(er, sa, ring_buffer, slot_size, task):
+    """Runs a single task on a frame in the ring, returns the result message for the pool."""
+    index, task_type, slot, shape, dtype, mode, position, label_id = task
+    try:
+        frame = np.ndarray(shape, dtype=dtype, buffer=ring_buffer, offset=slot * slot_size)
+        er_image = er.wrap_nparray(frame, mode)
+        if task_type == TASK_DET:
+            result = sa.run_det_np(er_image)
+        else:
+            result = sa.run_scl_np(er_image, position, label_id)
+        # release the view of the ring before the slot is reused
+        del er_image, frame
+        return index, slot, result, None
+    except SaError as e:
+        return index, slot, None, (e.internal_function_name, e.internal_error_code)
+    except Exception as e:
+        return index, slot, None, (type(e).__name__, str(e))
+
+
+def _process_worker(sa_lib_path, support_libs, sa_config_path, sa_config, shm_name, slot_size,
+                    task_queue, result_queue):
+    """Entry point of a worker process, initializes its own state and serves tasks until None is received."""
+    shm = shared_memory.SharedMemory(name=shm_name)
+    try:
+        ffi = FFI()
+        er = ER(ffi, sa_lib_path, support_libs)
+        sa = Seatsanalyzer(ffi, sa_lib_path, support_libs)
+        sa.init(sa_config_path, sa_config)
+        result_queue.put(None)
+    except SaError as e:
+        result_queue.put((e.internal_function_name, e.internal_error_code))
+        shm.close()
+        return
+    except Exception as e:
+        result_queue.put((type(e).__name__, str(e)))
+        shm.close()
+        return
+
+    while True:
+        task = task_queue.get()
+        if task is None:
+            break
+        result_queue.put(_process_task(er, sa, shm.buf, slot_size, task))
+
+    del sa, er
+    shm.close()
+
+
+def _thread_worker(er, sa, ring_buffer, slot_size, task_queue, result_queue):
+    """Worker thread serving tasks with its own clone until None is received."""
+    while True:
+        task = task_queue.get()
+        if task is None:
+            break
+        result_queue.put(_process_task(er, sa, ring_buffer, slot_size, task))
+
+
+class SeatsanalyzerPool:
+    """
+    Pool of N workers, each with its own SeatsAnalyzer state.
+    Worker processes load the models separately, worker threads share them as clones of one state (the C calls run
+    with the GIL released).
+    Only one run_det_many or run_scl_many generator may be active at a time, the generators share the ring and the
+    result queue. Starting another one before the previous is exhausted or closed raises RuntimeError.
+    If a worker dies, e.g. it is killed by the OS, waiting for a result raises RuntimeError and the pool has to be
+    closed.
+    """
+
+    def __init__(self, sa_lib_path: str, sa_config_path: str, sa_config: Optional[SaConfig] = None,
+                 num_workers: Optional[int] = None, use_processes: bool = True,
+                 max_frame_bytes: int = 1920 * 1080 * 4, num_slots: Optional[int] = None,
+                 support_libs: list = None) -> None:
+        """
+        :param sa_lib_path: Path to the SeatsAnalyzer library.
+        :param sa_config_path: Path to configuration file.
+        :param sa_config: Optional configuration structure used by all workers.
+        :param num_workers: Number of workers, number of CPUs if None.
+        :param use_processes: Worker processes with a shared-memory ring if True, worker threads otherwise.
+        :param max_frame_bytes: Largest frame accepted in bytes, the ring slots are rounded up to SLOT_ALIGNMENT bytes.
+        :param num_slots: Number of ring slots, i.e. the maximal number of frames in flight, 2 * num_workers if None.
+        :param support_libs: Optional list of libraries loaded before the SeatsAnalyzer library.
+        """
+        self.num_workers = num_workers if num_workers is not None else (multiprocessing.cpu_count() or 1)
+        self.use_processes = use_processes
+        # slots aligned to a cache line, so that the frames of any data type start aligned
+        self.slot_size = (max_frame_bytes + SLOT_ALIGNMENT - 1) // SLOT_ALIGNMENT * SLOT_ALIGNMENT
+        self.num_slots = num_slots if num_slots is not None else 2 * self.num_workers
+        self.__free_slots = list(range(self.num_slots))
+        self.__workers = []
+        self.__shm = None
+        self.__run_lock = threading.Lock()
+        self.__worker_error = None
+
+        if use_processes:
+            # spawn, the forked child must not inherit the loaded library state
+            context = multiprocessing.get_context("spawn")
+            self.__shm = shared_memory.SharedMemory(create=True, size=self.slot_size * self.num_slots)
+            self.__ring = self.__shm.buf
+            self.__task_queue = context.Queue()
+            self.__result_queue = context.Queue()
+            for _ in range(self.num_workers):
+                worker = context.Process(target=_process_worker,
+                                         args=(sa_lib_path, support_libs, sa_config_path, sa_config,
+                                               self.__shm.name, self.slot_size,
+                                               self.__task_queue, self.__result_queue),
+                                         daemon=True)
+                worker.start()
+                self.__workers.append(worker)
+            # wait until all workers are initialized
+            try:
+                errors = [self.__get_result() for _ in range(self.num_workers)]
+            except RuntimeError:
+                self.close()
+                raise
+            errors = [error for error in errors if error is not None]
+            if errors:
+                self.close()
+                raise SaError(*errors[0])
+        else:
+            self.__ring = memoryview(bytearray(self.slot_size * self.num_slots))
+            self.__task_queue = queue.Queue()
+            self.__result_queue = queue.Queue()
+            ffi = FFI()
+            er = ER(ffi, sa_lib_path, support_libs)
+            sa = Seatsanalyzer(ffi, sa_lib_path, support_libs)
+            sa.init(sa_config_path, sa_config)
+            # keep the states, they must outlive the threads
+            self.__states = [sa] + [sa.clone() for _ in range(self.num_workers - 1)]
+            for state in self.__states:
+                worker = threading.Thread(target=_thread_worker,
+                                          args=(er, state, self.__ring, self.slot_size,
+                                                self.__task_queue, self.__result_queue),
+                                          daemon=True)
+                worker.start()
+                self.__workers.append(worker)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+
+    def close(self):
+        """Stops the workers and releases the ring."""
+        for _ in self.__workers:
+            self.__task_queue.put(None)
+        for worker in self.__workers:
+            worker.join()
+        self.__workers = []
+        if self.__shm is not None:
+            self.__ring = None
+            self.__shm.close()
+            self.__shm.unlink()
+            self.__shm = None
+
+    def __submit(self, index, task_type, frame, mode, position=None, label_id=None):
+        frame = np.asarray(frame)
+        if frame.nbytes > self.slot_size:
+            raise ValueError("Frame of {} bytes does not fit into ring slot of {} bytes.".format(frame.nbytes,
+                                                                                                 self.slot_size))
+        slot = self.__free_slots.pop()
+        try:
+            # the only copy of the pixel data, strided frames are packed on the way
+            slot_view = np.ndarray(frame.shape, dtype=frame.dtype, buffer=self.__ring, offset=slot * self.slot_size)
+            slot_view[...] = frame
+            del slot_view
+            if position is not None:
+                position = tuple(float(value) for value in position)
+            self.__task_queue.put((index, task_type, slot, frame.shape, frame.dtype.str, mode, position, label_id))
+        except BaseException:
+            # the task was not submitted, the slot stays free
+            self.__free_slots.append(slot)
+            raise
+
+    def __get_result(self):
+        """Waits for the next result message, raises RuntimeError if a worker has died meanwhile."""
+        while self.__worker_error is None:
+            try:
+                return self.__result_queue.get(timeout=WORKER_POLL_INTERVAL)
+            except queue.Empty:
+                pass
+            for worker in self.__workers:
+                if not worker.is_alive():
+                    exitcode = getattr(worker, "exitcode", None)
+                    self.__worker_error = "Pool worker {} died with exit code {}.".format(worker.name, exitcode)
+                    break
+        raise RuntimeError(self.__worker_error)
+
+    def __collect(self):
+        index, slot, result, error = self.__get_result()
+        self.__free_slots.append(slot)
+        return index, result, error
+
+    def __run_many(self, tasks: Iterable, ordered: bool) -> Iterator[Tuple[int, np.ndarray]]:
+        if not self.__run_lock.acquire(blocking=False):
+            raise RuntimeError("Another run_det_many or run_scl_many generator of the pool is active.")
+        try:
+            yield from self.__run_tasks(tasks, ordered)
+        finally:
+            self.__run_lock.release()
+
+    def __run_tasks(self, tasks: Iterable, ordered: bool) -> Iterator[Tuple[int, np.ndarray]]:
+        tasks = iter(tasks)
+        num_submitted = 0
+        pending = 0
+        next_index = 0
+        finished = {}
+        exhausted = False
+        try:
+            while not exhausted or pending > 0:
+                # keep the ring full, collect results only when no slot is free
+                while not exhausted and self.__free_slots:
+                    try:
+                        task = next(tasks)
+                    except StopIteration:
+                        exhausted = True
+                        break
+                    self.__submit(num_submitted, *task)
+                    num_submitted += 1
+                    pending += 1
+                if pending == 0:
+                    break
+
+                index, result, error = self.__collect()
+                pending -= 1
+                if not ordered:
+                    if error is not None:
+                        raise SaError(*error)
+                    yield index, result
+                    continue
+
+                finished[index] = (result, error)
+                while next_index in finished:
+                    result, error = finished.pop(next_index)
+                    if error is not None:
+                        raise SaError(*error)
+                    yield next_index, result
+                    next_index += 1
+        finally:
+            # an error or an abandoned generator, the results still in flight are dropped to free their slots,
+            # nothing can be collected after a worker has died
+            while pending > 0 and self.__worker_error is None:
+                self.__collect()
+                pending -= 1
+
+    def run_det_many(self, frames: Iterable[np.ndarray], mode: str = "RGB",
+                     ordered: bool = True) -> Iterator[Tuple[int, np.ndarray]]:
+        """
+        Runs detection on all frames by the workers.
+        :param frames: Iterable of numpy frames, see ER.wrap_nparray.
+        :param mode: Mode of all frames, one of 'L', 'BGR', 'BGRA', 'RGB', 'RGBA', 'I420' or 'NV12'.
+        :param ordered: Results in the order of frames if True, in the order of completion otherwise.
+        :return: Generator of (frame index, Seatsanalyzer.run_det_np result).
+        """
+        return self.__run_many(((TASK_DET, frame, mode) for frame in frames), ordered)
+
+    def run_scl_many(self, crops: Iterable[Tuple[np.ndarray, object, int]], mode: str = "RGB",
+                     ordered: bool = True) -> Iterator[Tuple[int, np.ndarray]]:
+        """
+        Runs seat classification of all crops by the workers.
+        :param crops: Iterable of (numpy frame, position, label id), position and label id as in Seatsanalyzer.run_scl_np.
+        :param mode: Mode of all frames, one of 'L', 'BGR', 'BGRA', 'RGB', 'RGBA', 'I420' or 'NV12'.
+        :param ordered: Results in the order of crops if True, in the order of completion otherwise.
+        :return: Generator of (crop index, Seatsanalyzer.run_scl_np result).
+        """
+        return self.__run_many(((TASK_SCL, frame, mode, position, label_id) for frame, position, label_id in crops),
+                               ordered)